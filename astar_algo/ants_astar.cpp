@@ -3,14 +3,23 @@
 #include <limits>
 
 AnthillAStar::AnthillAStar(int total_rooms, int total_ants) 
-    : total_rooms(total_rooms), total_ants(total_ants) {
+    : total_rooms(total_rooms), total_ants(total_ants), connected_rooms(total_rooms) {
     graph.resize(total_rooms);
     room_capacity.resize(total_rooms, 0);
 }
 
-void AnthillAStar::add_tunnels(int a, int b) {
+bool AnthillAStar::add_tunnels(int a, int b) {
+    if (a == b || !tunnels.insert(a, b)) return false;
     graph[a].push_back(b);
     graph[b].push_back(a);
+    connected_rooms.connect(a, b);
+    return true;
+}
+
+void AnthillAStar::add_tunnels(const std::vector<std::pair<int, int>>& tunnel_list) {
+    reserve_tunnel_lists(graph, tunnel_list);
+    tunnels.reserve(tunnels.size() + tunnel_list.size());
+    for (const auto& [a, b] : tunnel_list) add_tunnels(a, b);
 }
 
 void AnthillAStar::set_room_capacity(int room, int c) {
@@ -21,15 +30,44 @@ bool AnthillAStar::is_full(int ants, int c) {
     return ants >= c;
 }
 
-bool AnthillAStar::has_tunnel(int a, int b) {
-    return std::find(graph[a].begin(), graph[a].end(), b) != graph[a].end();
+bool AnthillAStar::has_tunnel(int a, int b) const {
+    return tunnels.contains(a, b);
 }
 
-void AnthillAStar::simulate_astar() {
-    std::cout << "\n" << std::string(60, '=') << "\n";
-    std::cout << "  🐜 A* ANT SIMULATION - STARTING" << "\n";
-    std::cout << "  Rooms: " << total_rooms << " | Ants: " << total_ants << "\n";
-    std::cout << std::string(60, '=') << "\n\n";
+bool AnthillAStar::dormitory_reachable() const {
+    return total_rooms > 0 && connected_rooms.connected(0, total_rooms - 1);
+}
+
+void AnthillAStar::set_verbose(bool v) {
+    verbose = v;
+}
+
+void AnthillAStar::set_trace(TraceLog* t) {
+    trace = t;
+}
+
+std::ostream& AnthillAStar::out() {
+    return verbose ? static_cast<std::ostream&>(std::cout) : quiet;
+}
+
+int AnthillAStar::find_best_path(DijkstraWorkspace& workspace, std::vector<int>& path, long long* expanded) {
+    if (!dormitory_reachable()) {
+        path.clear();
+        if (expanded) *expanded = 0;
+        return -1;
+    }
+    int end_room = total_rooms - 1;
+    // Room numbers say nothing about how far apart rooms are, so |end - room| can
+    // overestimate and settle the dormitory on a longer route. At least one tunnel
+    // is left from any other room: admissible and consistent, so the route is shortest.
+    auto estimate = [end_room](int room) { return room == end_room ? 0 : 1; };
+    return best_first_search(AdjacencyList(graph), 0, end_room, workspace, &path, expanded, UnitCost(), estimate);
+}
+
+std::vector<int> AnthillAStar::simulation_path(long long* expanded) {
+    if (expanded) *expanded = 0;
+    // Its open set keeps a copy of the path in every node: no point filling it for nothing
+    if (!dormitory_reachable()) return {};
 
     int start_room = 0;
     int end_room = total_rooms - 1;
@@ -70,6 +108,7 @@ void AnthillAStar::simulate_astar() {
         if (g_scores[current.room] < current.g_score) {
             continue;
         }
+        if (expanded) (*expanded)++;
 
 
         // Explore neighbors
@@ -99,105 +138,113 @@ void AnthillAStar::simulate_astar() {
         }
     }
 
-    if (!path_found) {
-        std::cout << "❌ No path found from start to dormitory!\n";
-        return;
+    return path_found ? best_path : std::vector<int>();
+}
+
+SimulationStepper AnthillAStar::astar_simulation() {
+    std::vector<int> best_path = simulation_path();
+    if (best_path.empty()) return SimulationStepper();
+    return SimulationStepper({best_path}, room_capacity, total_ants, MoveRule::Single);
+}
+
+int AnthillAStar::simulate_astar(long long* expanded) {
+    if (verbose) {
+        out() << "\n" << std::string(60, '=') << "\n";
+        out() << "  🐜 A* ANT SIMULATION - STARTING" << "\n";
+        out() << "  Rooms: " << total_rooms << " | Ants: " << total_ants << "\n";
+        out() << std::string(60, '=') << "\n\n";
+    }
+
+    int end_room = total_rooms - 1;
+    std::vector<int> best_path = simulation_path(expanded);
+
+    if (best_path.empty()) {
+        out() << "❌ No path found from start to dormitory!\n";
+        return -1;
     }
 
     // Print the found path
-    std::cout << "🔍 Found A* path (" << best_path.size() - 1 << " steps): ";
-    for (size_t i = 0; i < best_path.size(); ++i) {
-        std::cout << best_path[i];
-        if (i < best_path.size() - 1) {
-            std::cout << " → ";
+    if (verbose) {
+        out() << "🔍 Found A* path (" << best_path.size() - 1 << " steps): ";
+        for (size_t i = 0; i < best_path.size(); ++i) {
+            out() << best_path[i];
+            if (i < best_path.size() - 1) {
+                out() << " → ";
+            }
         }
+        out() << "\n\n";
     }
-    std::cout << "\n\n";
 
     // Simulation of ant movement
-    std::vector<int> ants_per_room(total_rooms, 0);
-    ants_per_room[0] = total_ants;
-    int steps = 0;
-
-    std::cout << std::string(60, '=') << "\n";
-    std::cout << "  🚀 A* SIMULATION STARTING - MOVING ANTS TO DORMITORY" << "\n";
-    std::cout << "  Using path: ";
-    for (size_t i = 0; i < best_path.size(); ++i) {
-        std::cout << best_path[i];
-        if (i < best_path.size() - 1) std::cout << " → ";
-    }
-    std::cout << "\n" << std::string(60, '=') << "\n\n";
-
-    while (ants_per_room[end_room] < total_ants) {
-        std::cout << "\n⏱️  STEP " << steps << "\n";
-        std::cout << std::string(30, '-') << "\n";
-        
-        std::vector<int> next_ants = ants_per_room;
-        bool movement_occurred = false;
-
-        // Move ants one segment at a time in each step
-        for (int segment = 0; segment < static_cast<int>(best_path.size()) - 1; ++segment) {
-            // For each segment in the path, move ants if possible
-            for (int i = 0; i < static_cast<int>(best_path.size()) - 1; ++i) {
-                int from = best_path[i];
-                int to = best_path[i + 1];
-
-                // Only move ants from rooms that have ants and have capacity in the next room
-                if (next_ants[from] > 0) {
-                    int capacity_left = room_capacity[to] - next_ants[to];
-                    if (capacity_left > 0) {
-                        // Move at most 1 ant at a time per segment to simulate realistic movement
-                        int can_send = std::min(1, std::min(next_ants[from], capacity_left));
-                        
-                        if (can_send > 0) {
-                            movement_occurred = true;
-                            next_ants[from] -= can_send;
-                            next_ants[to] += can_send;
-                            std::cout << "  🐜 " << can_send << " ant(s) moved from Room " 
-                                    << from << " to Room " << to << "\n";
-                        }
-                    }
-                }
-            }
-            
-            // If we've moved ants, update the state and break to show the next step
-            if (movement_occurred) {
-                break;
-            }
+    SimulationStepper simulation({best_path}, room_capacity, total_ants, MoveRule::Single);
+    const std::vector<int>& ants_per_room = simulation.occupancy();
+
+    if (verbose) {
+        out() << std::string(60, '=') << "\n";
+        out() << "  🚀 A* SIMULATION STARTING - MOVING ANTS TO DORMITORY" << "\n";
+        out() << "  Using path: ";
+        for (size_t i = 0; i < best_path.size(); ++i) {
+            out() << best_path[i];
+            if (i < best_path.size() - 1) out() << " → ";
         }
+        out() << "\n" << std::string(60, '=') << "\n\n";
+    }
 
+    if (trace) trace->start_run(room_capacity, total_ants);
+
+    while (!simulation.done()) {
+        int steps = simulation.steps();
+        if (trace) trace->record(TraceEvent::step(steps));
+        if (verbose) {
+            out() << "\n⏱️  STEP " << steps << "\n";
+            out() << std::string(30, '-') << "\n";
+        }
 
-        // Update ant counts
-        ants_per_room = next_ants;
+        // Move at most 1 ant at a time per segment to simulate realistic movement
+        simulation.advance();
+        for (const AntMove& move : simulation.moves()) {
+            if (trace) trace->record(TraceEvent::move(move.ants, move.from, move.to));
+            if (!verbose) continue;
+            out() << "  🐜 " << move.ants << " ant(s) moved from Room " 
+                << move.from << " to Room " << move.to << "\n";
+        }
 
         // Print current room status
-        std::cout << "\n  ROOM STATUS (" << ants_per_room[end_room] << "/" << total_ants 
+        if (verbose) {
+            out() << "\n  ROOM STATUS (" << ants_per_room[end_room] << "/" << total_ants
                   << " ants in dormitory):\n";
-        for (int i = 0; i < total_rooms; ++i) {
-            std::string room_type = (i == 0) ? "START" : 
-                                   (i == end_room) ? "DORMITORY" : "ROOM";
-            std::cout << "  • " << room_type << " " << i << ": " 
+            for (int i = 0; i < total_rooms; ++i) {
+                std::string room_type = (i == 0) ? "START" : 
+                                       (i == end_room) ? "DORMITORY" : "ROOM";
+                out() << "  • " << room_type << " " << i << ": " 
                       << ants_per_room[i] << "/" << room_capacity[i] << " ants";
-            if (i == end_room && ants_per_room[i] > 0) {
-                std::cout << " 🏠";
+                if (i == end_room && ants_per_room[i] > 0) {
+                    out() << " 🏠";
+                }
+                out() << "\n";
             }
-            std::cout << "\n";
         }
 
-        if (!movement_occurred && ants_per_room[end_room] < total_ants) {
-            std::cout << "\n⚠️  No movement possible - ants are stuck! Check room capacities.\n";
+        if (simulation.stuck()) {
+            if (trace) trace->record(TraceEvent::stuck(steps));
+            out() << "\n⚠️  No movement possible - ants are stuck! Check room capacities.\n";
             break;
         }
 
-        steps++;
-        
         // Small delay for better visualization (500ms)
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        if (verbose) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        }
     }
 
-    std::cout << "\n" << std::string(60, '=') << "\n";
-    std::cout << "  🎉 A* SIMULATION COMPLETE! 🎉" << "\n";
-    std::cout << "  All " << total_ants << " ants reached the dormitory" << "\n";
-    std::cout << "  Total steps: " << steps << "\n";
-    std::cout << std::string(60, '=') << "\n\n";
+    if (verbose) {
+        out() << "\n" << std::string(60, '=') << "\n";
+        out() << "  🎉 A* SIMULATION COMPLETE! 🎉" << "\n";
+        out() << "  All " << total_ants << " ants reached the dormitory" << "\n";
+        out() << "  Total steps: " << simulation.steps() << "\n";
+        out() << std::string(60, '=') << "\n\n";
+    }
+    int result = simulation.result();
+    if (trace) trace->record(TraceEvent::finish(result));
+    return result;
 }
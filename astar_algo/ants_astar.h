@@ -10,6 +10,12 @@
 #include <string>
 #include <thread>
 #include <chrono>
+#include "null_stream.h"
+#include "room_connectivity.h"
+#include "search_core.h"
+#include "simulation_stepper.h"
+#include "tunnel_set.h"
+#include "trace_log.h"
 
 class AnthillAStar {
     struct Node {
@@ -27,6 +33,21 @@ class AnthillAStar {
     int total_ants;
     std::vector<std::vector<int>> graph;
     std::vector<int> room_capacity;
+    TunnelSet tunnels;  // Every tunnel of graph once, for has_tunnel and duplicates
+    RoomConnectivity connected_rooms;
+    bool verbose = true;
+    TraceLog* trace = nullptr;
+
+    NullStream quiet;  // Per solver, so quiet runs on several threads share no stream
+
+    // std::cout, or a stream that discards everything when verbose is off
+    std::ostream& out();
+
+    // Route simulate_astar walks: A* with the path-dependent heuristic below, which
+    // weighs capacities against length, so the route is not always the shortest.
+    // Empty if the dormitory cannot be reached. expanded, if given, receives the
+    // number of rooms expanded.
+    std::vector<int> simulation_path(long long* expanded = nullptr);
 
     // Enhanced heuristic function that considers both distance and room capacities
     int heuristic(int from, int to, const std::vector<int>& path = {}, int current_ants = 0) {
@@ -69,11 +90,37 @@ class AnthillAStar {
 
 public:
     AnthillAStar(int total_rooms, int total_ants);
-    void add_tunnels(int a, int b);
+    // False for a duplicate or a room-to-itself tunnel, which are not added
+    bool add_tunnels(int a, int b);
+    void add_tunnels(const std::vector<std::pair<int, int>>& tunnel_list);
     void set_room_capacity(int room, int capacity);
     bool is_full(int ants, int capacity);
-    bool has_tunnel(int a, int b);
-    void simulate_astar();
+    bool has_tunnel(int a, int b) const;
+
+    // Whether the tunnels added so far join the start and the dormitory (no search).
+    // find_best_path and simulate_astar stop here when they do not.
+    bool dormitory_reachable() const;
+    const RoomConnectivity& connectivity() const { return connected_rooms; }
+
+    // Quiet mode: simulate_astar neither prints nor pauses between steps
+    void set_verbose(bool verbose);
+
+    // simulate_astar also records its steps and moves into trace (null: no trace)
+    void set_trace(TraceLog* trace);
+
+    // Headless A* from room 0 to the dormitory, one step per tunnel, with an
+    // admissible heuristic: path is a route with the fewest tunnels, as from BFS.
+    // Returns its number of tunnels, or -1; expanded, if given, receives the number
+    // of rooms expanded. simulate_astar walks simulation_path instead, which is not
+    // always shortest.
+    int find_best_path(DijkstraWorkspace& workspace, std::vector<int>& path, long long* expanded = nullptr);
+
+    // Returns the number of steps taken, or -1 on failure. expanded, if given,
+    // receives the number of rooms its A* expanded.
+    int simulate_astar(long long* expanded = nullptr);
+
+    // The same run as a resumable simulation the caller advances step by step, silently
+    SimulationStepper astar_simulation();
 };
 
 #endif // ANTS_ASTAR_H
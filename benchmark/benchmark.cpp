@@ -6,7 +6,15 @@
 #include <filesystem>
 #include <fstream>
 #include <algorithm>
+#include <cstdlib>
+#include <thread>
+#include <memory>
 #include "benchmark.h"
+#include "perf_counters.h"
+#include "memory_stats.h"
+#include "report.h"
+#include "reports.h"
+#include "result_cache.h"
 
 const std::vector<std::string> ANTHILL_NAMES = {
     "Small Hill (4 rooms)",
@@ -22,14 +30,128 @@ const int NUM_ANTHILLS = 7;
 
 struct BenchmarkResult {
     std::string anthill_name;
-    int bfs_steps;
-    double bfs_time_ms;
-    int astar_steps;
-    double astar_time_ms;
-    int dijkstra_steps;
-    double dijkstra_time_ms;
+    Measurement bfs;
+    Measurement astar;
+    Measurement dijkstra;
 };
 
+// Runs one solver `repeat` times, collecting the wall time distribution and
+// optionally sampling hardware counters around each call
+Measurement measure(const std::string& anthill_name, const std::string& algorithm,
+                    int (*solver)(int, SearchStats*), int anthill_num,
+                    PerfCounters* counters, int repeat) {
+    Measurement m;
+    m.anthill_name = anthill_name;
+    m.algorithm = algorithm;
+
+    std::vector<double> samples_ms;
+    std::vector<PerfSample> perf_samples;
+
+    for (int r = 0; r < repeat; r++) {
+        SearchStats stats;
+        PeakRssTracker rss;
+
+        rss.start();
+        AllocSnapshot allocs_before = AllocSnapshot::now();
+        if (counters) counters->start();
+        auto start = std::chrono::high_resolution_clock::now();
+        m.steps = solver(anthill_num, &stats);
+        auto end = std::chrono::high_resolution_clock::now();
+        if (counters) perf_samples.push_back(counters->stop());
+        AllocSnapshot allocs = AllocSnapshot::now() - allocs_before;
+        m.peak_rss_delta_kb = std::max(m.peak_rss_delta_kb, rss.stop());
+
+        samples_ms.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        if (stats.from_cache) {
+            m.cache_hits++;
+        } else {
+            m.expanded = stats.expanded_nodes;
+        }
+        m.allocations = allocs.allocations;
+        m.bytes_allocated = allocs.bytes;
+    }
+
+    m.timing = TimingStats::from_samples(samples_ms);
+    if (!perf_samples.empty()) {
+        m.perf = PerfSample::mean(perf_samples);
+    }
+    return m;
+}
+
+// Prints a counter value, or "n/a" when the counter was not available
+void print_metric(double value, int width) {
+    if (value < 0) {
+        std::cout << std::setw(width) << "n/a";
+    } else {
+        std::cout << std::setw(width) << std::fixed << std::setprecision(2) << value;
+    }
+}
+
+void print_counters_table(const std::vector<BenchmarkResult>& results) {
+    const int name_width = 30;
+    const int algo_width = 10;
+    const int value_width = 12;
+
+    std::cout << "\nHardware counters (per expanded node):\n";
+    std::cout << std::left
+              << std::setw(name_width) << "ANTHILL"
+              << std::setw(algo_width) << "ALGO"
+              << std::right
+              << std::setw(value_width) << "EXPANDED"
+              << std::setw(value_width) << "IPC"
+              << std::setw(value_width) << "L1D MISS"
+              << std::setw(value_width) << "LLC MISS"
+              << std::setw(value_width) << "BR MISS"
+              << "\n" << std::string(100, '=') << "\n";
+
+    for (const auto& result : results) {
+        for (const Measurement* m : {&result.bfs, &result.astar, &result.dijkstra}) {
+            std::cout << std::left << std::setw(name_width) << result.anthill_name
+                      << std::setw(algo_width) << m->algorithm
+                      << std::right << std::setw(value_width) << m->expanded;
+            print_metric(m->perf.ipc(), value_width);
+            print_metric(PerfSample::per_node(m->perf.l1d_misses, m->expanded), value_width);
+            print_metric(PerfSample::per_node(m->perf.llc_misses, m->expanded), value_width);
+            print_metric(PerfSample::per_node(m->perf.branch_misses, m->expanded), value_width);
+            std::cout << "\n";
+        }
+    }
+}
+
+void print_memory_table(const std::vector<BenchmarkResult>& results) {
+    const int name_width = 30;
+    const int algo_width = 10;
+    const int value_width = 16;
+
+    std::cout << "\nMemory footprint (per run):\n";
+    std::cout << std::left
+              << std::setw(name_width) << "ANTHILL"
+              << std::setw(algo_width) << "ALGO"
+              << std::right
+              << std::setw(value_width) << "TIME (ms)"
+              << std::setw(value_width) << "ALLOCATIONS"
+              << std::setw(value_width) << "BYTES"
+              << std::setw(value_width) << "PEAK RSS +KB"
+              << "\n" << std::string(104, '=') << "\n";
+
+    for (const auto& result : results) {
+        for (const Measurement* m : {&result.bfs, &result.astar, &result.dijkstra}) {
+            std::cout << std::left << std::setw(name_width) << result.anthill_name
+                      << std::setw(algo_width) << m->algorithm
+                      << std::right
+                      << std::setw(value_width) << std::fixed << std::setprecision(3) << m->timing.mean
+                      << std::setw(value_width) << m->allocations
+                      << std::setw(value_width) << m->bytes_allocated;
+            if (m->peak_rss_delta_kb < 0) {
+                std::cout << std::setw(value_width) << "n/a";
+            } else {
+                std::cout << std::setw(value_width) << m->peak_rss_delta_kb;
+            }
+            std::cout << "\n";
+        }
+    }
+}
+
 void print_results_table(const std::vector<BenchmarkResult>& results) {
     const int name_width = 30;
     const int steps_width = 12;
@@ -52,26 +174,26 @@ void print_results_table(const std::vector<BenchmarkResult>& results) {
     // Rows
     for (const auto& result : results) {
         std::string fastest_algo = "BFS";
-        double min_time = result.bfs_time_ms;
+        double min_time = result.bfs.timing.mean;
         
-        if (result.astar_time_ms < min_time) {
+        if (result.astar.timing.mean < min_time) {
             fastest_algo = "A*";
-            min_time = result.astar_time_ms;
+            min_time = result.astar.timing.mean;
         }
         
-        if (result.dijkstra_time_ms < min_time) {
+        if (result.dijkstra.timing.mean < min_time) {
             fastest_algo = "Dijkstra";
-            min_time = result.dijkstra_time_ms;
+            min_time = result.dijkstra.timing.mean;
         }
         
         std::cout << std::left << std::setw(name_width) << result.anthill_name
                   << std::right
-                  << std::setw(steps_width) << result.bfs_steps
-                  << std::setw(time_width) << std::fixed << std::setprecision(3) << result.bfs_time_ms
-                  << std::setw(steps_width) << result.astar_steps
-                  << std::setw(time_width) << std::fixed << std::setprecision(3) << result.astar_time_ms
-                  << std::setw(steps_width) << result.dijkstra_steps
-                  << std::setw(time_width) << std::fixed << std::setprecision(3) << result.dijkstra_time_ms
+                  << std::setw(steps_width) << result.bfs.steps
+                  << std::setw(time_width) << std::fixed << std::setprecision(3) << result.bfs.timing.mean
+                  << std::setw(steps_width) << result.astar.steps
+                  << std::setw(time_width) << std::fixed << std::setprecision(3) << result.astar.timing.mean
+                  << std::setw(steps_width) << result.dijkstra.steps
+                  << std::setw(time_width) << std::fixed << std::setprecision(3) << result.dijkstra.timing.mean
                   << std::setw(algo_width) << fastest_algo
                   << "\n";
     }
@@ -86,14 +208,14 @@ void print_results_table(const std::vector<BenchmarkResult>& results) {
         int dijkstra_wins = 0;
         
         for (const auto& result : results) {
-            total_bfs_time += result.bfs_time_ms;
-            total_astar_time += result.astar_time_ms;
-            total_dijkstra_time += result.dijkstra_time_ms;
+            total_bfs_time += result.bfs.timing.mean;
+            total_astar_time += result.astar.timing.mean;
+            total_dijkstra_time += result.dijkstra.timing.mean;
             
-            double min_time = std::min({result.bfs_time_ms, result.astar_time_ms, result.dijkstra_time_ms});
+            double min_time = std::min({result.bfs.timing.mean, result.astar.timing.mean, result.dijkstra.timing.mean});
             
-            if (result.bfs_time_ms == min_time) bfs_wins++;
-            else if (result.astar_time_ms == min_time) astar_wins++;
+            if (result.bfs.timing.mean == min_time) bfs_wins++;
+            else if (result.astar.timing.mean == min_time) astar_wins++;
             else dijkstra_wins++;
         }
         
@@ -141,39 +263,229 @@ void print_results_table(const std::vector<BenchmarkResult>& results) {
     }
 }
 
-int main() {
+void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--perf] [--repeat N] [--csv FILE] [--json FILE]"
+              << " [--compare BASELINE.csv] [--threshold PCT] [--paths-scaling] [--threads N]"
+              << " [--oracle] [--sssp-scaling] [--delta N] [--bfs-scaling]"
+              << " [--hpa] [--map-size N] [--cluster N] [--replan]"
+              << " [--cache] [--cache-dir DIR] [--trace FILE] [--stepping N]"
+              << " [--checkpoint FILE] [--checkpoint-every N] [--compact] [--reachability] [--dense]\n";
+}
+
+int main(int argc, char** argv) {
+    bool use_perf = false;
+    int repeat = 1;
+    double threshold_pct = 5.0;
+    std::string csv_path;
+    std::string json_path;
+    std::string baseline_path;
+    bool path_scaling = false;
+    bool oracle = false;
+    bool sssp_scaling = false;
+    bool bfs_scaling = false;
+    bool hpa = false;
+    bool replan = false;
+    bool use_cache = false;
+    std::string cache_directory;
+    std::string trace_path;
+    int stepping = 0;
+    std::string checkpoint_path;
+    int checkpoint_interval = 1000;
+    bool compact = false;
+    bool reachability = false;
+    bool dense = false;
+    int map_size = 2048;
+    int cluster_size = 32;
+    int delta = 64;
+    int max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--perf") {
+            use_perf = true;
+        } else if (arg == "--repeat" && has_value) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--csv" && has_value) {
+            csv_path = argv[++i];
+        } else if (arg == "--json" && has_value) {
+            json_path = argv[++i];
+        } else if (arg == "--compare" && has_value) {
+            baseline_path = argv[++i];
+        } else if (arg == "--threshold" && has_value) {
+            threshold_pct = std::atof(argv[++i]);
+        } else if (arg == "--paths-scaling") {
+            path_scaling = true;
+        } else if (arg == "--threads" && has_value) {
+            max_threads = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--oracle") {
+            oracle = true;
+        } else if (arg == "--sssp-scaling") {
+            sssp_scaling = true;
+        } else if (arg == "--delta" && has_value) {
+            delta = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--bfs-scaling") {
+            bfs_scaling = true;
+        } else if (arg == "--hpa") {
+            hpa = true;
+        } else if (arg == "--map-size" && has_value) {
+            map_size = std::max(2, std::atoi(argv[++i]));
+        } else if (arg == "--cluster" && has_value) {
+            cluster_size = std::max(2, std::atoi(argv[++i]));
+        } else if (arg == "--replan") {
+            replan = true;
+        } else if (arg == "--cache") {
+            use_cache = true;
+        } else if (arg == "--cache-dir" && has_value) {
+            use_cache = true;
+            cache_directory = argv[++i];
+        } else if (arg == "--trace" && has_value) {
+            trace_path = argv[++i];
+        } else if (arg == "--stepping" && has_value) {
+            stepping = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--checkpoint" && has_value) {
+            checkpoint_path = argv[++i];
+        } else if (arg == "--checkpoint-every" && has_value) {
+            checkpoint_interval = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--compact") {
+            compact = true;
+        } else if (arg == "--reachability") {
+            reachability = true;
+        } else if (arg == "--dense") {
+            dense = true;
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Load the baseline first so a bad path fails before the (possibly long) run
+    std::vector<Measurement> baseline;
+    if (!baseline_path.empty()) {
+        std::string error;
+        if (!read_csv(baseline_path, baseline, error)) {
+            std::cerr << "Cannot load baseline: " << error << "\n";
+            return 1;
+        }
+    }
+
     std::cout << "Starting benchmark of BFS vs A* vs Dijkstra algorithms...\n\n";
+
+    // With --cache, repeated hills (and, with a directory, earlier runs) skip the solvers
+    std::unique_ptr<ResultCache> cache;
+    if (use_cache) {
+        cache = std::make_unique<ResultCache>(1024, cache_directory);
+        use_result_cache(cache.get());
+    }
+
+    PerfCounters perf_counters;
+    PerfCounters* counters = nullptr;
+    if (use_perf) {
+        if (perf_counters.available()) {
+            counters = &perf_counters;
+        } else {
+            std::cout << "Hardware counters unavailable (" << perf_counters.unavailable_reason()
+                      << "), reporting wall time only.\n\n";
+        }
+    }
     
     std::vector<BenchmarkResult> results;
+    std::vector<Measurement> measurements;
+    prepare_solvers();
     
     for (int i = 0; i < NUM_ANTHILLS; i++) {
         std::string anthill_name = ANTHILL_NAMES[i];
         
         std::cout << "Running benchmark for " << anthill_name << "...\n";
         
-        // Run BFS
-        auto bfs_start = std::chrono::high_resolution_clock::now();
-        int bfs_steps = run_bfs(i);
-        auto bfs_end = std::chrono::high_resolution_clock::now();
-        double bfs_time = std::chrono::duration<double, std::milli>(bfs_end - bfs_start).count();
+        BenchmarkResult result;
+        result.anthill_name = anthill_name;
+        result.bfs = measure(anthill_name, "BFS", run_bfs, i, counters, repeat);
+        result.astar = measure(anthill_name, "A*", run_astar, i, counters, repeat);
+        result.dijkstra = measure(anthill_name, "Dijkstra", run_dijkstra, i, counters, repeat);
         
-        // Run A*
-        auto astar_start = std::chrono::high_resolution_clock::now();
-        int astar_steps = run_astar(i);
-        auto astar_end = std::chrono::high_resolution_clock::now();
-        double astar_time = std::chrono::duration<double, std::milli>(astar_end - astar_start).count();
-        
-        // Run Dijkstra
-        auto dijkstra_start = std::chrono::high_resolution_clock::now();
-        int dijkstra_steps = run_dijkstra(i);
-        auto dijkstra_end = std::chrono::high_resolution_clock::now();
-        double dijkstra_time = std::chrono::duration<double, std::milli>(dijkstra_end - dijkstra_start).count();
-        
-        results.push_back({anthill_name, bfs_steps, bfs_time, astar_steps, astar_time, dijkstra_steps, dijkstra_time});
+        results.push_back(result);
+        measurements.insert(measurements.end(), {result.bfs, result.astar, result.dijkstra});
     }
     
-    std::cout << "\nBenchmark results:\n";
+    std::cout << "\nBenchmark results";
+    if (repeat > 1) std::cout << " (mean of " << repeat << " runs)";
+    std::cout << ":\n";
     print_results_table(results);
+    print_memory_table(results);
+
+    if (cache) {
+        std::cout << "\nResult cache: " << cache->summary() << "\n"
+                  << "Runs answered by the cache time a lookup: --csv and --json count them in cache_hits"
+                  << " and --compare does not test their rows.\n";
+    }
+
+    if (counters) {
+        print_counters_table(results);
+    }
+
+    if (path_scaling) {
+        print_path_scaling(max_threads);
+    }
+
+    if (oracle) {
+        print_oracle_report();
+    }
+
+    if (sssp_scaling) {
+        print_sssp_scaling(max_threads, delta);
+    }
+
+    if (bfs_scaling) {
+        print_bfs_scaling(max_threads);
+    }
+
+    if (hpa) {
+        print_hpa_report(map_size, cluster_size);
+    }
+
+    if (replan) {
+        print_replan_report();
+    }
+
+    if (!trace_path.empty()) {
+        print_trace_report(trace_path);
+    }
+
+    if (stepping > 0) {
+        print_stepping_report(stepping, max_threads);
+    }
+
+    if (!checkpoint_path.empty()) {
+        print_checkpoint_report(checkpoint_path, checkpoint_interval);
+    }
+
+    if (compact) {
+        print_compact_report();
+    }
+
+    if (reachability) {
+        print_reachability_report();
+    }
+
+    if (dense) {
+        print_dense_report();
+    }
+
+    if (!csv_path.empty() && !write_csv(csv_path, measurements)) {
+        std::cerr << "Cannot write " << csv_path << "\n";
+        return 1;
+    }
+    if (!json_path.empty() && !write_json(json_path, measurements)) {
+        std::cerr << "Cannot write " << json_path << "\n";
+        return 1;
+    }
+
+    // A non-zero exit code lets CI gate on performance regressions
+    if (!baseline.empty() && compare_with_baseline(measurements, baseline, threshold_pct) > 0) {
+        return 2;
+    }
     
     return 0;
-}
\ No newline at end of file
+}
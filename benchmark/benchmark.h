@@ -1,16 +1,38 @@
 #pragma once
 
+// Each run_* function runs the simulation of one of the room hills (room_hills.h)
+// with the production solver, in quiet mode.
+
+class ResultCache;
+
+// Routes the run_* functions through cache (nullptr to stop). A hit skips the
+// solver entirely, so it reports no expanded nodes.
+void use_result_cache(ResultCache* cache);
+
+// Builds the solvers of every room hill once, so the run_* functions time the
+// simulation alone. Without it each run_* call builds its solver first.
+void prepare_solvers();
+
+// Counters filled in by the solvers while they search
+struct SearchStats {
+    long long expanded_nodes = 0;  // Rooms expanded by the path search the simulation ran
+    bool from_cache = false;       // Answered by the result cache: no solver ran
+};
+
 // Function to run BFS algorithm on a specific anthill
 // anthill_num: Index of the anthill to test (0-6)
-// Returns the number of steps taken to solve the anthill, or -1 if no path found
-int run_bfs(int anthill_num);
+// stats: Optional, receives search counters
+// Returns the number of simulation steps, or -1 if the ants cannot all reach the dormitory
+int run_bfs(int anthill_num, SearchStats* stats = nullptr);
 
 // Function to run A* algorithm on a specific anthill
 // anthill_num: Index of the anthill to test (0-6)
-// Returns the number of steps taken to solve the anthill, or -1 if no path found
-int run_astar(int anthill_num);
+// stats: Optional, receives search counters
+// Returns the number of simulation steps, or -1 if the ants cannot all reach the dormitory
+int run_astar(int anthill_num, SearchStats* stats = nullptr);
 
 // Function to run Dijkstra algorithm on a specific anthill
 // anthill_num: Index of the anthill to test (0-6)
-// Returns the number of steps taken to solve the anthill, or -1 if no path found
-int run_dijkstra(int anthill_num);
\ No newline at end of file
+// stats: Optional, receives search counters
+// Returns the number of simulation steps, or -1 if the ants cannot all reach the dormitory
+int run_dijkstra(int anthill_num, SearchStats* stats = nullptr);
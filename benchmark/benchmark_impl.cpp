@@ -1,561 +1,110 @@
 #include "benchmark.h"
-#include <vector>
-#include <queue>
-#include <unordered_map>
-#include <unordered_set>
-#include <cmath>
 #include <iostream>
-#include <climits>
-#include <string>
-#include <chrono>
-#include <iomanip>
+#include <vector>
+#include "room_hills.h"
+#include "ants.h"
+#include "ants_astar.h"
+#include "ants_dijkstra.h"
+#include "result_cache.h"
 
-// Forward declarations
 namespace {
-    struct Point {
-        size_t x, y;
-        Point() : x(0), y(0) {}
-        Point(size_t x, size_t y) : x(x), y(y) {}
-        bool operator==(const Point& other) const {
-            return x == other.x && y == other.y;
-        }
-        bool operator!=(const Point& other) const {
-            return !(*this == other);
-        }
-        bool operator<(const Point& other) const {
-            return std::tie(x, y) < std::tie(other.x, other.y);
-        }
-    };
+    ResultCache* result_cache = nullptr;
 
-    struct PointHash {
-        size_t operator()(const Point& p) const {
-            return std::hash<size_t>()(p.x) ^ (std::hash<size_t>()(p.y) << 1);
-        }
-    };
-
-    struct Node {
-        Point pos;
-        int steps;
-        int heuristic;
-        std::vector<Point> path;
-        
-        bool operator>(const Node& other) const {
-            return (steps + heuristic) > (other.steps + other.heuristic);
-        }
-    };
+    // Solvers built by prepare_solvers, one per room hill
+    std::vector<Anthill> prepared_bfs;
+    std::vector<AnthillAStar> prepared_astar;
+    std::vector<AnthillDijkstra> prepared_dijkstra;
 
-    struct DijkstraNode {
-        Point pos;
-        int distance;
-        std::vector<Point> path;
-        
-        bool operator>(const DijkstraNode& other) const {
-            return distance > other.distance;
+    const RoomHill* get_anthill(int anthill_num) {
+        const std::vector<RoomHill>& hills = room_hills();
+        if (anthill_num < 0 || anthill_num >= static_cast<int>(hills.size())) {
+            std::cerr << "Invalid anthill number: " << anthill_num << std::endl;
+            return nullptr;
         }
-    };
+        return &hills[anthill_num];
+    }
 
-    bool is_valid_move(const std::vector<std::string>& grid, size_t x, size_t y) {
-        if (grid.empty()) return false;
-        return x < grid.size() && y < grid[0].size() && grid[x][y] != '#';
+    // Builds the solver for one hill in quiet mode
+    template <typename Solver>
+    Solver build_quiet(const RoomHill& hill) {
+        Solver solver = hill.build<Solver>();
+        solver.set_verbose(false);
+        return solver;
     }
 
-    int manhattan_distance(const Point& a, const Point& b) {
-        return static_cast<int>((a.x > b.x ? a.x - b.x : b.x - a.x) + 
-                              (a.y > b.y ? a.y - b.y : b.y - a.y));
+    // Runs simulate on the prepared solver of the hill, or on one built now if
+    // prepare_solvers was not called. A simulation leaves its solver as it found it,
+    // so one solver serves every repetition.
+    template <typename Solver, typename Simulate>
+    int with_solver(std::vector<Solver>& prepared, int anthill_num, const RoomHill& hill, Simulate&& simulate) {
+        if (anthill_num < static_cast<int>(prepared.size())) return simulate(prepared[anthill_num]);
+        Solver solver = build_quiet<Solver>(hill);
+        return simulate(solver);
     }
-}
 
-// BFS implementation
-int run_bfs(int anthill_num) {
-    std::vector<std::string> grid;
-    Point start, end;
-    
-    // Define anthills
-    switch (anthill_num) {
-        case 0: // Small Hill (4 rooms)
-            grid = {
-                "#######",
-                "#S...#",
-                "#.###.#",
-                "#.#.#.#",
-                "#....##",
-                "#E#.#.#",
-                "#######"
-            };
-            start = Point(1, 1);
-            end = Point(5, 1);
-            break;
-            
-        case 1: // Medium Hill 1 (4 rooms)
-            grid = {
-                "#######",
-                "#S....#",
-                "#.#####",
-                "#.....#",
-                "#####.#",
-                "#E....#",
-                "#######"
-            };
-            start = Point(1, 1);
-            end = Point(5, 1);
-            break;
-            
-        case 2: // Medium Hill 2 (4 rooms, loop)
-            grid = {
-                "#######",
-                "#S....#",
-                "#.###.#",
-                "#.#...#",
-                "#.#####",
-                "#E....#",
-                "#######"
-            };
-            start = Point(1, 1);
-            end = Point(5, 1);
-            break;
-            
-        case 3: // Medium Hill 3 (6 rooms)
-            grid = {
-                "#######",
-                "#S....#",
-                "#.#####",
-                "#.....#",
-                "#.#####",
-                "#E....#",
-                "#######"
-            };
-            start = Point(1, 1);
-            end = Point(5, 1);
-            break;
-            
-        case 4: // Large Hill (8 rooms)
-            grid = {
-                "########",
-                "#S.....#",
-                "#.#####.",
-                "#.....#.",
-                "#.#####.",
-                "#.....#.",
-                "#E#####.",
-                "########"
-            };
-            start = Point(1, 1);
-            end = Point(6, 1);
-            break;
-            
-        case 5: // Extra Large Hill (16 rooms)
-            grid = {
-                "##########",
-                "#S.......#",
-                "#.########",
-                "#........#",
-                "########.#",
-                "#........#",
-                "#.########",
-                "#........#",
-                "##########"
-            };
-            start = Point(1, 1);
-            end = Point(7, 8);
-            break;
-            
-        case 6: // King Hill (23 rooms)
-            grid = {
-                "###########",
-                "#S........#",
-                "#.########.",
-                "#..........",
-                "#.########.",
-                "#..........",
-                "#.########.",
-                "#..........",
-                "#.########.",
-                "#..........",
-                "#.########.",
-                "#..........",
-                "#.########.",
-                "#E........#",
-                "###########"
-            };
-            start = Point(1, 1);
-            end = Point(13, 1);
-            break;
-            
-        default:
-            std::cerr << "Invalid anthill number: " << anthill_num << std::endl;
-            return -1;
+    // Same query names as the query server, so both can share a cache directory
+    int cached(const RoomHill& hill, const std::string& query, SearchStats* stats,
+               const std::function<int()>& simulate) {
+        if (!result_cache) return simulate();
+        bool computed = false;
+        int result = result_cache->get_or_compute(ResultCache::hash_hill(hill), query, [&]() {
+            computed = true;
+            return simulate();
+        });
+        if (stats) stats->from_cache = !computed;
+        return result;
     }
-    
-    // BFS
-    std::queue<Node> q;
-    std::unordered_set<Point, PointHash> visited;
-    
-    q.push(Node{start, 0, 0, {start}});
-    visited.insert(start);
-    
-    const std::vector<Point> moves = {Point(0, 1), Point(1, 0), Point(0, -1), Point(-1, 0)};
-    
-    while (!q.empty()) {
-        Node current = q.front();
-        q.pop();
-        
-        if (current.pos == end) {
-            return current.steps;
-        }
-        
-        for (const auto& move : moves) {
-            Point next_pos(current.pos.x + move.x, current.pos.y + move.y);
-            
-            if (is_valid_move(grid, next_pos.x, next_pos.y) && 
-                visited.find(next_pos) == visited.end()) {
-                
-                visited.insert(next_pos);
-                std::vector<Point> new_path = current.path;
-                new_path.push_back(next_pos);
-                q.push(Node{next_pos, current.steps + 1, 0, new_path});
-            }
-        }
+
+    long long* expanded_counter(SearchStats* stats) {
+        return stats ? &stats->expanded_nodes : nullptr;
     }
-    
-    return -1;
 }
 
-// A* implementation
-int run_astar(int anthill_num) {
-    std::vector<std::string> grid;
-    Point start, end;
-    
-    // Define anthills (same as BFS)
-    switch (anthill_num) {
-        case 0: // Small Hill (4 rooms)
-            grid = {
-                "#######",
-                "#S...#",
-                "#.###.#",
-                "#.#.#.#",
-                "#....##",
-                "#E#.#.#",
-                "#######"
-            };
-            start = Point(1, 1);
-            end = Point(5, 1);
-            break;
-            
-        case 1: // Medium Hill 1 (4 rooms)
-            grid = {
-                "#######",
-                "#S....#",
-                "#.#####",
-                "#.....#",
-                "#####.#",
-                "#E....#",
-                "#######"
-            };
-            start = Point(1, 1);
-            end = Point(5, 1);
-            break;
-            
-        case 2: // Medium Hill 2 (4 rooms, loop)
-            grid = {
-                "#######",
-                "#S....#",
-                "#.###.#",
-                "#.#...#",
-                "#.#####",
-                "#E....#",
-                "#######"
-            };
-            start = Point(1, 1);
-            end = Point(5, 1);
-            break;
-            
-        case 3: // Medium Hill 3 (6 rooms)
-            grid = {
-                "#######",
-                "#S....#",
-                "#.#####",
-                "#.....#",
-                "#.#####",
-                "#E....#",
-                "#######"
-            };
-            start = Point(1, 1);
-            end = Point(5, 1);
-            break;
-            
-        case 4: // Large Hill (8 rooms)
-            grid = {
-                "########",
-                "#S.....#",
-                "#.#####.",
-                "#.....#.",
-                "#.#####.",
-                "#.....#.",
-                "#E#####.",
-                "########"
-            };
-            start = Point(1, 1);
-            end = Point(6, 1);
-            break;
-            
-        case 5: // Extra Large Hill (16 rooms)
-            grid = {
-                "##########",
-                "#S.......#",
-                "#.########",
-                "#........#",
-                "########.#",
-                "#........#",
-                "#.########",
-                "#........#",
-                "##########"
-            };
-            start = Point(1, 1);
-            end = Point(7, 8);
-            break;
-            
-        case 6: // King Hill (23 rooms)
-            grid = {
-                "###########",
-                "#S........#",
-                "#.########.",
-                "#..........",
-                "#.########.",
-                "#..........",
-                "#.########.",
-                "#..........",
-                "#.########.",
-                "#..........",
-                "#.########.",
-                "#..........",
-                "#.########.",
-                "#E........#",
-                "###########"
-            };
-            start = Point(1, 1);
-            end = Point(13, 1);
-            break;
-            
-        default:
-            std::cerr << "Invalid anthill number: " << anthill_num << std::endl;
-            return -1;
-    }
-    
-    // A*
-    std::priority_queue<Node, std::vector<Node>, std::greater<>> open_set;
-    std::unordered_map<Point, int, PointHash> g_score;
-    
-    for (size_t i = 0; i < grid.size(); ++i) {
-        for (size_t j = 0; j < grid[0].size(); ++j) {
-            g_score[Point(i, j)] = INT_MAX;
-        }
-    }
-    
-    g_score[start] = 0;
-    open_set.push(Node{start, 0, manhattan_distance(start, end), {start}});
-    
-    const std::vector<Point> moves = {Point(0, 1), Point(1, 0), Point(0, -1), Point(-1, 0)};
-    
-    while (!open_set.empty()) {
-        Node current = open_set.top();
-        open_set.pop();
-        
-        if (current.pos == end) {
-            return current.steps;
-        }
-        
-        if (current.steps > g_score[current.pos]) {
-            continue;
-        }
-        
-        for (const auto& move : moves) {
-            Point next_pos(current.pos.x + move.x, current.pos.y + move.y);
-            
-            if (is_valid_move(grid, next_pos.x, next_pos.y)) {
-                int tentative_g_score = current.steps + 1;
-                
-                if (tentative_g_score < g_score[next_pos]) {
-                    g_score[next_pos] = tentative_g_score;
-                    int h_score = manhattan_distance(next_pos, end);
-                    std::vector<Point> new_path = current.path;
-                    new_path.push_back(next_pos);
-                    open_set.push(Node{next_pos, tentative_g_score, h_score, new_path});
-                }
-            }
-        }
-    }
-    
-    return -1;
+void use_result_cache(ResultCache* cache) {
+    result_cache = cache;
 }
 
-// Dijkstra implementation
-int run_dijkstra(int anthill_num) {
-    std::vector<std::string> grid;
-    Point start, end;
-    
-    // Define anthills (same as others)
-    switch (anthill_num) {
-        case 0: // Small Hill (4 rooms)
-            grid = {
-                "#######",
-                "#S...#",
-                "#.###.#",
-                "#.#.#.#",
-                "#....##",
-                "#E#.#.#",
-                "#######"
-            };
-            start = Point(1, 1);
-            end = Point(5, 1);
-            break;
-            
-        case 1: // Medium Hill 1 (4 rooms)
-            grid = {
-                "#######",
-                "#S....#",
-                "#.#####",
-                "#.....#",
-                "#####.#",
-                "#E....#",
-                "#######"
-            };
-            start = Point(1, 1);
-            end = Point(5, 1);
-            break;
-            
-        case 2: // Medium Hill 2 (4 rooms, loop)
-            grid = {
-                "#######",
-                "#S....#",
-                "#.###.#",
-                "#.#...#",
-                "#.#####",
-                "#E....#",
-                "#######"
-            };
-            start = Point(1, 1);
-            end = Point(5, 1);
-            break;
-            
-        case 3: // Medium Hill 3 (6 rooms)
-            grid = {
-                "#######",
-                "#S....#",
-                "#.#####",
-                "#.....#",
-                "#.#####",
-                "#E....#",
-                "#######"
-            };
-            start = Point(1, 1);
-            end = Point(5, 1);
-            break;
-            
-        case 4: // Large Hill (8 rooms)
-            grid = {
-                "########",
-                "#S.....#",
-                "#.#####.",
-                "#.....#.",
-                "#.#####.",
-                "#.....#.",
-                "#E#####.",
-                "########"
-            };
-            start = Point(1, 1);
-            end = Point(6, 1);
-            break;
-            
-        case 5: // Extra Large Hill (16 rooms)
-            grid = {
-                "##########",
-                "#S.......#",
-                "#.########",
-                "#........#",
-                "########.#",
-                "#........#",
-                "#.########",
-                "#........#",
-                "##########"
-            };
-            start = Point(1, 1);
-            end = Point(7, 8);
-            break;
-            
-        case 6: // King Hill (23 rooms)
-            grid = {
-                "###########",
-                "#S........#",
-                "#.########.",
-                "#..........",
-                "#.########.",
-                "#..........",
-                "#.########.",
-                "#..........",
-                "#.########.",
-                "#..........",
-                "#.########.",
-                "#..........",
-                "#.########.",
-                "#E........#",
-                "###########"
-            };
-            start = Point(1, 1);
-            end = Point(13, 1);
-            break;
-            
-        default:
-            std::cerr << "Invalid anthill number: " << anthill_num << std::endl;
-            return -1;
-    }
-    
-    // Dijkstra
-    std::priority_queue<DijkstraNode, std::vector<DijkstraNode>, std::greater<>> pq;
-    std::unordered_map<Point, int, PointHash> distances;
-    
-    for (size_t i = 0; i < grid.size(); ++i) {
-        for (size_t j = 0; j < grid[0].size(); ++j) {
-            distances[Point(i, j)] = INT_MAX;
-        }
-    }
-    
-    distances[start] = 0;
-    pq.push({start, 0, {start}});
-    
-    std::unordered_set<Point, PointHash> visited;
-    const std::vector<Point> moves = {Point(0, 1), Point(1, 0), Point(0, -1), Point(-1, 0)};
-    
-    while (!pq.empty()) {
-        DijkstraNode current = pq.top();
-        pq.pop();
-        
-        if (visited.find(current.pos) != visited.end()) {
-            continue;
-        }
-        
-        visited.insert(current.pos);
-        
-        if (current.pos == end) {
-            return current.path.size() - 1;
-        }
-        
-        for (const auto& move : moves) {
-            Point next_pos(current.pos.x + move.x, current.pos.y + move.y);
-            
-            if (is_valid_move(grid, next_pos.x, next_pos.y) && 
-                visited.find(next_pos) == visited.end()) {
-                
-                int new_distance = current.distance + 1;
-                
-                if (new_distance < distances[next_pos]) {
-                    distances[next_pos] = new_distance;
-                    std::vector<Point> new_path = current.path;
-                    new_path.push_back(next_pos);
-                    pq.push({next_pos, new_distance, new_path});
-                }
-            }
-        }
+void prepare_solvers() {
+    prepared_bfs.clear();
+    prepared_astar.clear();
+    prepared_dijkstra.clear();
+    for (const RoomHill& hill : room_hills()) {
+        prepared_bfs.push_back(build_quiet<Anthill>(hill));
+        prepared_astar.push_back(build_quiet<AnthillAStar>(hill));
+        prepared_dijkstra.push_back(build_quiet<AnthillDijkstra>(hill));
     }
-    
-    return -1;
-}
\ No newline at end of file
+}
+
+// BFS: the production Anthill, all simple paths then the simulation
+int run_bfs(int anthill_num, SearchStats* stats) {
+    const RoomHill* hill = get_anthill(anthill_num);
+    if (!hill) return -1;
+
+    return cached(*hill, "simulate_bfs", stats, [&]() {
+        return with_solver(prepared_bfs, anthill_num, *hill,
+                           [&](Anthill& anthill) { return anthill.simulate_dfs(expanded_counter(stats)); });
+    });
+}
+
+// A*: the production AnthillAStar
+int run_astar(int anthill_num, SearchStats* stats) {
+    const RoomHill* hill = get_anthill(anthill_num);
+    if (!hill) return -1;
+
+    return cached(*hill, "simulate_astar", stats, [&]() {
+        return with_solver(prepared_astar, anthill_num, *hill,
+                           [&](AnthillAStar& anthill) { return anthill.simulate_astar(expanded_counter(stats)); });
+    });
+}
+
+// Dijkstra: the production AnthillDijkstra
+int run_dijkstra(int anthill_num, SearchStats* stats) {
+    const RoomHill* hill = get_anthill(anthill_num);
+    if (!hill) return -1;
+
+    return cached(*hill, "simulate_dijkstra", stats, [&]() {
+        return with_solver(prepared_dijkstra, anthill_num, *hill, [&](AnthillDijkstra& anthill) {
+            return anthill.simulate_dijkstra(expanded_counter(stats));
+        });
+    });
+}
@@ -0,0 +1,296 @@
+#include "hpa_star.h"
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+
+GridMap::GridMap(const std::vector<std::string>& rows)
+    : height(static_cast<int>(rows.size())), width(rows.empty() ? 0 : static_cast<int>(rows[0].size())) {
+    open_bits.assign((static_cast<size_t>(height) * width + 63) / 64, 0);
+    size_t cell = 0;
+    for (const std::string& row : rows) {
+        for (char c : row) {
+            if (c != '#') open_bits[cell >> 6] |= uint64_t{1} << (cell & 63);
+            cell++;
+        }
+    }
+}
+
+GridMap::GridMap(int rows, int cols, const std::vector<char>& open_cells)
+    : height(rows), width(cols), open_bits((open_cells.size() + 63) / 64, 0) {
+    for (size_t cell = 0; cell < open_cells.size(); cell++) {
+        if (open_cells[cell]) open_bits[cell >> 6] |= uint64_t{1} << (cell & 63);
+    }
+}
+
+int GridMap::manhattan(int a, int b) const {
+    return std::abs(row_of(a) - row_of(b)) + std::abs(col_of(a) - col_of(b));
+}
+
+GridMap make_random_map(int size, double wall_ratio, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution wall(wall_ratio);
+    std::vector<char> open_cells(static_cast<size_t>(size) * size);
+    for (char& cell : open_cells) cell = !wall(rng);
+    return GridMap(size, size, open_cells);
+}
+
+int flat_astar(const GridMap& map, int start, int goal, DijkstraWorkspace& workspace,
+               std::vector<int>* path, long long* expanded) {
+    if (!map.open(start) || !map.open(goal)) return -1;
+
+    long long expanded_here = 0;
+    auto manhattan = [&map, goal](int cell) { return map.manhattan(cell, goal); };
+    int steps = best_first_search(map, start, goal, workspace, path, &expanded_here, UnitCost(), manhattan);
+    if (expanded) *expanded += expanded_here;
+    return steps;
+}
+
+HierarchicalMap::HierarchicalMap(const GridMap& map, int cluster_size)
+    : map(map), cluster_size(std::max(2, cluster_size)) {
+    const int size = this->cluster_size;
+    cluster_cols = (map.cols() + size - 1) / size;
+    const int cluster_rows = (map.rows() + size - 1) / size;
+    cluster_nodes.resize(static_cast<size_t>(cluster_rows) * cluster_cols);
+    local_distance.resize(static_cast<size_t>(size) * size);
+    local_previous.resize(static_cast<size_t>(size) * size);
+    local_queue.reserve(static_cast<size_t>(size) * size);
+
+    // Open runs along each border between two clusters, one cluster band at a time.
+    // Vertical borders first (cells side by side), then horizontal ones (one above the other).
+    for (int border = size; border < map.cols(); border += size) {
+        for (int band = 0; band < map.rows(); band += size) {
+            int run = 0;
+            int band_end = std::min(map.rows(), band + size);
+            for (int row = band; row <= band_end; ++row) {
+                bool crossing = row < band_end && map.open(map.cell(row, border - 1)) && map.open(map.cell(row, border));
+                if (crossing) {
+                    run++;
+                } else if (run > 0) {
+                    add_entrances(map.cell(row - run, border - 1), map.cell(row - run, border), run, map.cols());
+                    run = 0;
+                }
+            }
+        }
+    }
+    for (int border = size; border < map.rows(); border += size) {
+        for (int band = 0; band < map.cols(); band += size) {
+            int run = 0;
+            int band_end = std::min(map.cols(), band + size);
+            for (int col = band; col <= band_end; ++col) {
+                bool crossing = col < band_end && map.open(map.cell(border - 1, col)) && map.open(map.cell(border, col));
+                if (crossing) {
+                    run++;
+                } else if (run > 0) {
+                    add_entrances(map.cell(border - 1, col - run), map.cell(border, col - run), run, 1);
+                    run = 0;
+                }
+            }
+        }
+    }
+
+    for (size_t cluster = 0; cluster < cluster_nodes.size(); ++cluster) {
+        connect_cluster(static_cast<int>(cluster));
+    }
+}
+
+int HierarchicalMap::cluster_of(int cell) const {
+    return (map.row_of(cell) / cluster_size) * cluster_cols + map.col_of(cell) / cluster_size;
+}
+
+int HierarchicalMap::local_index(int cluster, int cell) const {
+    int top = (cluster / cluster_cols) * cluster_size;
+    int left = (cluster % cluster_cols) * cluster_size;
+    return (map.row_of(cell) - top) * cluster_size + (map.col_of(cell) - left);
+}
+
+int HierarchicalMap::node_for(int cell) {
+    auto [it, inserted] = node_at.emplace(cell, static_cast<int>(node_cell.size()));
+    if (inserted) {
+        node_cell.push_back(cell);
+        edges.emplace_back();
+        cluster_nodes[cluster_of(cell)].push_back(it->second);
+    }
+    return it->second;
+}
+
+// cell_a and cell_b start a run of `run_length` crossings; `step` moves along the run
+void HierarchicalMap::add_entrances(int cell_a, int cell_b, int run_length, int step) {
+    std::vector<int> offsets;
+    if (run_length < 6) {
+        offsets.push_back(run_length / 2);
+    } else {
+        offsets.push_back(0);
+        offsets.push_back(run_length - 1);
+    }
+
+    for (int offset : offsets) {
+        int a = node_for(cell_a + offset * step);
+        int b = node_for(cell_b + offset * step);
+        edges[a].push_back({b, 1});
+        edges[b].push_back({a, 1});
+    }
+}
+
+void HierarchicalMap::cluster_bfs(int from) {
+    const int cluster = cluster_of(from);
+    const int top = (cluster / cluster_cols) * cluster_size;
+    const int left = (cluster % cluster_cols) * cluster_size;
+    const int height = std::min(map.rows(), top + cluster_size) - top;
+    const int width = std::min(map.cols(), left + cluster_size) - left;
+
+    // Works on local indices (row * cluster_size + col inside the cluster) to keep
+    // divisions out of the inner loop
+    std::fill(local_distance.begin(), local_distance.end(), -1);
+    local_queue.clear();
+    int origin = local_index(cluster, from);
+    local_queue.push_back(origin);
+    local_distance[origin] = 0;
+    local_previous[origin] = -1;
+
+    for (size_t head = 0; head < local_queue.size(); ++head) {
+        int index = local_queue[head];
+        int row = index / cluster_size;
+        int col = index % cluster_size;
+        int next_distance = local_distance[index] + 1;
+        int map_cell = map.cell(top + row, left + col);
+
+        auto visit = [&](int next_index, int next_cell) {
+            if (local_distance[next_index] < 0 && map.open(next_cell)) {
+                local_distance[next_index] = next_distance;
+                local_previous[next_index] = index;
+                local_queue.push_back(next_index);
+            }
+        };
+        if (row > 0) visit(index - cluster_size, map_cell - map.cols());
+        if (row + 1 < height) visit(index + cluster_size, map_cell + map.cols());
+        if (col > 0) visit(index - 1, map_cell - 1);
+        if (col + 1 < width) visit(index + 1, map_cell + 1);
+    }
+}
+
+void HierarchicalMap::connect_cluster(int cluster) {
+    const std::vector<int>& nodes = cluster_nodes[cluster];
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        cluster_bfs(node_cell[nodes[i]]);
+        for (size_t j = i + 1; j < nodes.size(); ++j) {
+            int steps = local_distance[local_index(cluster, node_cell[nodes[j]])];
+            if (steps > 0) {
+                edges[nodes[i]].push_back({nodes[j], steps});
+                edges[nodes[j]].push_back({nodes[i], steps});
+            }
+        }
+    }
+}
+
+HierarchicalMap::Route HierarchicalMap::find_route(int start, int goal, long long* expanded) {
+    Route route;
+    if (!map.open(start) || !map.open(goal)) return route;
+
+    // Start and goal join the abstract graph as two extra nodes for this query only
+    const int start_node = abstract_nodes();
+    const int goal_node = start_node + 1;
+    auto cell_of = [&](int node) {
+        return node == start_node ? start : node == goal_node ? goal : node_cell[node];
+    };
+
+    std::vector<std::pair<int, int>> start_links;
+    cluster_bfs(start);
+    for (int node : cluster_nodes[cluster_of(start)]) {
+        int steps = local_distance[local_index(cluster_of(start), node_cell[node])];
+        if (steps >= 0) start_links.push_back({node, steps});
+    }
+    if (cluster_of(goal) == cluster_of(start)) {
+        int steps = local_distance[local_index(cluster_of(start), goal)];
+        if (steps >= 0) start_links.push_back({goal_node, steps});
+    }
+
+    std::vector<std::pair<int, int>> goal_links;  // (node, steps to the goal)
+    cluster_bfs(goal);
+    for (int node : cluster_nodes[cluster_of(goal)]) {
+        int steps = local_distance[local_index(cluster_of(goal), node_cell[node])];
+        if (steps >= 0) goal_links.push_back({node, steps});
+    }
+
+    DijkstraWorkspace& workspace = abstract_workspace;
+    workspace.reset(start_node + 2);
+    workspace.relax(start_node, 0, -1);
+    workspace.push(start_node, map.manhattan(start, goal));
+
+    auto visit = [&](int from, int to, int steps) {
+        int g = workspace.distance(from) + steps;
+        if (!workspace.is_visited(to) && g < workspace.distance(to)) {
+            workspace.relax(to, g, from);
+            workspace.push(to, g + map.manhattan(cell_of(to), goal));
+        }
+    };
+
+    while (!workspace.queue_empty()) {
+        int node = workspace.pop().room;
+        if (workspace.is_visited(node)) continue;
+        workspace.mark_visited(node);
+        if (expanded) (*expanded)++;
+
+        if (node == goal_node) {
+            route.length = workspace.distance(goal_node);
+            workspace.build_path(goal_node, route.waypoints);
+            for (int& waypoint : route.waypoints) waypoint = cell_of(waypoint);
+            return route;
+        }
+
+        if (node == start_node) {
+            for (const auto& [next, steps] : start_links) visit(node, next, steps);
+            continue;
+        }
+        for (const auto& [next, steps] : edges[node]) visit(node, next, steps);
+        for (const auto& [linked, steps] : goal_links) {
+            if (linked == node) visit(node, goal_node, steps);
+        }
+    }
+    return route;
+}
+
+std::vector<int> HierarchicalMap::refine(const Route& route) {
+    std::vector<int> cells;
+    if (route.waypoints.empty()) return cells;
+    cells.push_back(route.waypoints[0]);
+
+    for (size_t i = 0; i + 1 < route.waypoints.size(); ++i) {
+        int from = route.waypoints[i];
+        int to = route.waypoints[i + 1];
+        if (from == to) continue;
+
+        if (cluster_of(from) != cluster_of(to)) {
+            cells.push_back(to);  // Entrance edge: one step across the border
+            continue;
+        }
+
+        cluster_bfs(from);
+        size_t segment_start = cells.size();
+        int cluster = cluster_of(from);
+        int top = (cluster / cluster_cols) * cluster_size;
+        int left = (cluster % cluster_cols) * cluster_size;
+        for (int index = local_index(cluster, to); local_previous[index] >= 0; index = local_previous[index]) {
+            cells.push_back(map.cell(top + index / cluster_size, left + index % cluster_size));
+        }
+        std::reverse(cells.begin() + segment_start, cells.end());
+    }
+    return cells;
+}
+
+long long HierarchicalMap::abstract_edges() const {
+    long long total = 0;
+    for (const auto& list : edges) total += static_cast<long long>(list.size());
+    return total / 2;
+}
+
+size_t HierarchicalMap::memory_bytes() const {
+    size_t bytes = node_cell.capacity() * sizeof(int);
+    bytes += edges.capacity() * sizeof(edges[0]);
+    for (const auto& list : edges) bytes += list.capacity() * sizeof(list[0]);
+    bytes += cluster_nodes.capacity() * sizeof(cluster_nodes[0]);
+    for (const auto& list : cluster_nodes) bytes += list.capacity() * sizeof(int);
+    bytes += node_at.bucket_count() * sizeof(void*) + node_at.size() * (2 * sizeof(int) + 2 * sizeof(void*));
+    bytes += (local_distance.capacity() + local_previous.capacity() + local_queue.capacity()) * sizeof(int);
+    bytes += abstract_workspace.memory_bytes();
+    return bytes;
+}
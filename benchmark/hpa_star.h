@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "search_core.h"
+
+// Grid map with 4-connected moves, cells numbered row * cols + col. '#' is a wall,
+// as in the benchmark anthills. Usable as the Graph policy of best_first_search.
+//
+// Open cells are one bit each, 64 to a word: a 2048x2048 map takes 512 KB
+// instead of 4 MB, and the four neighbour tests of an expansion mostly hit the
+// same two or three words.
+class GridMap {
+    int height;
+    int width;
+    std::vector<uint64_t> open_bits;
+
+public:
+    explicit GridMap(const std::vector<std::string>& rows);
+    // open_cells holds one entry per cell, non-zero if the cell is open
+    GridMap(int rows, int cols, const std::vector<char>& open_cells);
+
+    int rows() const { return height; }
+    int cols() const { return width; }
+    int cell(int row, int col) const { return row * width + col; }
+    int row_of(int cell) const { return cell / width; }
+    int col_of(int cell) const { return cell % width; }
+    bool open(int cell) const { return (open_bits[cell >> 6] >> (cell & 63)) & 1; }
+    int manhattan(int a, int b) const;
+
+    int size() const { return height * width; }
+    size_t memory_bytes() const { return open_bits.capacity() * sizeof(uint64_t); }
+
+    template <typename Visit>
+    void for_each_neighbor(int cell, Visit&& visit) const {
+        int row = row_of(cell);
+        int col = col_of(cell);
+        if (row > 0 && open(cell - width)) visit(cell - width);
+        if (row + 1 < height && open(cell + width)) visit(cell + width);
+        if (col > 0 && open(cell - 1)) visit(cell - 1);
+        if (col + 1 < width && open(cell + 1)) visit(cell + 1);
+    }
+};
+
+// Square map of `size` cells a side where each cell is a wall with probability wall_ratio
+GridMap make_random_map(int size, double wall_ratio, unsigned seed);
+
+// Cell-by-cell A* with the Manhattan heuristic. Returns the number of steps, or -1.
+// path is optional; expanded, if given, is increased by the number of cells expanded.
+int flat_astar(const GridMap& map, int start, int goal, DijkstraWorkspace& workspace,
+               std::vector<int>* path = nullptr, long long* expanded = nullptr);
+
+// HPA* (Botea, Müller & Schaeffer): the map is cut into square clusters. Every
+// run of open cells along a cluster border gets one entrance (two at its ends
+// if it is 6 cells or longer). Entrances are nodes of an abstract graph, joined
+// by a 1-step edge across the border and by the in-cluster distance to every
+// other entrance of the same cluster.
+//
+// A query links start and goal to the entrances of their clusters with a BFS
+// limited to the cluster, then runs A* on the abstract graph. The route it returns
+// only lists waypoints; refine() turns it into cells one cluster at a time, so the
+// cost of a full cell path is only paid when a caller asks for it. Routes are
+// near-optimal: they may be a few steps longer than flat A*.
+class HierarchicalMap {
+public:
+    struct Route {
+        int length = -1;             // Steps, -1 if the goal is unreachable
+        std::vector<int> waypoints;  // Start, entrance cells, goal
+    };
+
+    HierarchicalMap(const GridMap& map, int cluster_size);
+
+    Route find_route(int start, int goal, long long* expanded = nullptr);
+    std::vector<int> refine(const Route& route);
+
+    int abstract_nodes() const { return static_cast<int>(node_cell.size()); }
+    long long abstract_edges() const;
+    size_t memory_bytes() const;  // Abstract graph, cell index and search buffers
+
+private:
+    const GridMap& map;
+    int cluster_size;
+    int cluster_cols;
+
+    std::vector<int> node_cell;
+    std::vector<std::vector<std::pair<int, int>>> edges;  // (node, steps)
+    std::vector<std::vector<int>> cluster_nodes;
+    std::unordered_map<int, int> node_at;                  // Cell -> node
+
+    DijkstraWorkspace abstract_workspace;
+    std::vector<int> local_distance;  // BFS scratch indexed by local_index()
+    std::vector<int> local_previous;
+    std::vector<int> local_queue;
+
+    int cluster_of(int cell) const;
+    int node_for(int cell);
+    void add_entrances(int cell_a, int cell_b, int run_length, int step);
+    void connect_cluster(int cluster);
+
+    // BFS from `from` without leaving its cluster; distances land in local_distance
+    // and predecessors (as local indices) in local_previous
+    void cluster_bfs(int from);
+    int local_index(int cluster, int cell) const;
+};
@@ -0,0 +1,112 @@
+#include "memory_stats.h"
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+
+#ifdef __unix__
+#include <sys/resource.h>
+#endif
+
+namespace {
+    std::atomic<long long> allocation_count{0};
+    std::atomic<long long> allocated_bytes{0};
+
+    void* counted_alloc(std::size_t size) {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        allocated_bytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    void* counted_aligned_alloc(std::size_t size, std::size_t alignment) {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        allocated_bytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+        // aligned_alloc requires the size to be a multiple of the alignment
+        std::size_t rounded = (size + alignment - 1) / alignment * alignment;
+        return std::aligned_alloc(alignment, rounded == 0 ? alignment : rounded);
+    }
+
+    // Reads a "Key:   1234 kB" line from /proc/self/status, or -1
+    long read_status_kb(const std::string& key) {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.compare(0, key.size(), key) == 0 && line.size() > key.size() && line[key.size()] == ':') {
+                return std::strtol(line.c_str() + key.size() + 1, nullptr, 10);
+            }
+        }
+        return -1;
+    }
+
+    bool reset_peak_rss() {
+        std::ofstream clear_refs("/proc/self/clear_refs");
+        if (!clear_refs) return false;
+        clear_refs << "5";
+        clear_refs.flush();
+        return static_cast<bool>(clear_refs);
+    }
+
+    long rusage_peak_kb() {
+#ifdef __unix__
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0) return usage.ru_maxrss;
+#endif
+        return -1;
+    }
+}
+
+// Counting replacements for the global allocation functions.
+// The array and nothrow forms forward to these by default.
+void* operator new(std::size_t size) {
+    void* p = counted_alloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    void* p = counted_aligned_alloc(size, static_cast<std::size_t>(alignment));
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+AllocSnapshot AllocSnapshot::now() {
+    AllocSnapshot snapshot;
+    snapshot.allocations = allocation_count.load(std::memory_order_relaxed);
+    snapshot.bytes = allocated_bytes.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+AllocSnapshot AllocSnapshot::operator-(const AllocSnapshot& before) const {
+    AllocSnapshot delta;
+    delta.allocations = allocations - before.allocations;
+    delta.bytes = bytes - before.bytes;
+    return delta;
+}
+
+void PeakRssTracker::start() {
+    kernel_reset = reset_peak_rss();
+    baseline_kb = kernel_reset ? read_status_kb("VmRSS") : rusage_peak_kb();
+}
+
+long PeakRssTracker::stop() const {
+    long peak_kb = kernel_reset ? read_status_kb("VmHWM") : rusage_peak_kb();
+    if (peak_kb < 0 || baseline_kb < 0) return -1;
+    return peak_kb > baseline_kb ? peak_kb - baseline_kb : 0;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+// Heap activity seen by the counting global operator new (see memory_stats.cpp).
+// Counters are process-wide and only ever increase; take a snapshot before and
+// after a solver call and subtract.
+struct AllocSnapshot {
+    long long allocations = 0;
+    long long bytes = 0;
+
+    static AllocSnapshot now();
+    AllocSnapshot operator-(const AllocSnapshot& before) const;
+};
+
+// Tracks the peak resident set size around a solver call.
+// On Linux the kernel high-water mark is reset before each call (/proc/self/clear_refs),
+// so the delta is the growth caused by that call alone. Elsewhere it falls back to
+// getrusage, whose peak never decreases, so later runs may report 0.
+class PeakRssTracker {
+    long baseline_kb = 0;
+    bool kernel_reset = false;
+
+public:
+    void start();
+
+    // Peak RSS growth in KB since start(), or -1 if it cannot be measured
+    long stop() const;
+};
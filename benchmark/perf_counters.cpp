@@ -0,0 +1,137 @@
+#include "perf_counters.h"
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+double PerfSample::ipc() const {
+    if (cycles <= 0 || instructions < 0) return -1.0;
+    return static_cast<double>(instructions) / static_cast<double>(cycles);
+}
+
+double PerfSample::per_node(long long counter, long long expanded_nodes) {
+    if (counter < 0 || expanded_nodes <= 0) return -1.0;
+    return static_cast<double>(counter) / static_cast<double>(expanded_nodes);
+}
+
+PerfSample PerfSample::mean(const std::vector<PerfSample>& samples) {
+    PerfSample result;
+    if (samples.empty()) return result;
+
+    auto average = [&](long long PerfSample::*counter) {
+        long long sum = 0;
+        for (const auto& sample : samples) {
+            if (sample.*counter < 0) return -1LL;
+            sum += sample.*counter;
+        }
+        return sum / static_cast<long long>(samples.size());
+    };
+
+    result.cycles = average(&PerfSample::cycles);
+    result.instructions = average(&PerfSample::instructions);
+    result.l1d_misses = average(&PerfSample::l1d_misses);
+    result.llc_misses = average(&PerfSample::llc_misses);
+    result.branch_misses = average(&PerfSample::branch_misses);
+    return result;
+}
+
+#ifdef __linux__
+namespace {
+    int open_event(unsigned int type, unsigned long long config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        // User space only, so it also works with perf_event_paranoid = 2
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    constexpr unsigned long long cache_event(unsigned long long cache, unsigned long long op,
+                                             unsigned long long result) {
+        return cache | (op << 8) | (result << 16);
+    }
+}
+
+PerfCounters::PerfCounters() {
+    fds[CYCLES] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    int cycles_errno = errno;
+    fds[INSTRUCTIONS] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    fds[L1D_MISSES] = open_event(PERF_TYPE_HW_CACHE,
+        cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS));
+    fds[LLC_MISSES] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    fds[BRANCH_MISSES] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+
+    if (!available()) {
+        error = std::string("perf_event_open: ") + std::strerror(cycles_errno);
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+void PerfCounters::start() {
+    for (int fd : fds) {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+PerfSample PerfCounters::stop() {
+    long long values[NUM_EVENTS];
+    for (int i = 0; i < NUM_EVENTS; ++i) {
+        values[i] = -1;
+        if (fds[i] >= 0) {
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            long long value = 0;
+            if (read(fds[i], &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value))) {
+                values[i] = value;
+            }
+        }
+    }
+
+    PerfSample sample;
+    sample.cycles = values[CYCLES];
+    sample.instructions = values[INSTRUCTIONS];
+    sample.l1d_misses = values[L1D_MISSES];
+    sample.llc_misses = values[LLC_MISSES];
+    sample.branch_misses = values[BRANCH_MISSES];
+    return sample;
+}
+#else
+PerfCounters::PerfCounters() : error("hardware counters require Linux perf_event_open") {
+    for (int& fd : fds) fd = -1;
+}
+
+PerfCounters::~PerfCounters() {}
+
+void PerfCounters::start() {}
+
+PerfSample PerfCounters::stop() {
+    return PerfSample{};
+}
+#endif
+
+bool PerfCounters::available() const {
+    for (int fd : fds) {
+        if (fd >= 0) return true;
+    }
+    return false;
+}
+
+const std::string& PerfCounters::unavailable_reason() const {
+    return error;
+}
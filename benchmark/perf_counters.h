@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Hardware counter values collected around a single solver call.
+// A counter that could not be opened is reported as -1.
+struct PerfSample {
+    long long cycles = -1;
+    long long instructions = -1;
+    long long l1d_misses = -1;
+    long long llc_misses = -1;
+    long long branch_misses = -1;
+
+    // Instructions per cycle, or -1 if either counter is missing
+    double ipc() const;
+
+    // counter / expanded_nodes, or -1 if the counter is missing
+    static double per_node(long long counter, long long expanded_nodes);
+
+    // Per-counter mean over several runs (a counter missing in any run stays -1)
+    static PerfSample mean(const std::vector<PerfSample>& samples);
+};
+
+// Thin wrapper around Linux perf_event_open.
+// Each event is opened on its own so that a missing PMU event (common in VMs)
+// only disables that column instead of the whole report.
+class PerfCounters {
+    enum Event { CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, BRANCH_MISSES, NUM_EVENTS };
+
+    int fds[NUM_EVENTS];
+    std::string error;
+
+public:
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // True if at least one counter could be opened
+    bool available() const;
+
+    // Reason why counters are unavailable (empty when available)
+    const std::string& unavailable_reason() const;
+
+    void start();
+    PerfSample stop();
+};
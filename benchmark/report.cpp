@@ -0,0 +1,325 @@
+#include "report.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+namespace {
+    const char* const CSV_COLUMNS[] = {
+        "anthill", "algorithm", "steps", "expanded", "samples",
+        "mean_ms", "stddev_ms", "min_ms", "median_ms", "p95_ms", "max_ms",
+        "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses",
+        "allocations", "bytes_allocated", "peak_rss_delta_kb", "cache_hits"
+    };
+
+    // Columns added after the first file format; older baselines load without them
+    bool is_optional_column(const std::string& column) {
+        return column == "allocations" || column == "bytes_allocated" || column == "peak_rss_delta_kb"
+            || column == "cache_hits";
+    }
+
+    // One-sided 99% quantile of the standard normal distribution
+    const double Z_ALPHA = 2.326348;
+
+    std::string csv_quote(const std::string& field) {
+        if (field.find_first_of(",\"\n") == std::string::npos) return field;
+        std::string quoted = "\"";
+        for (char c : field) {
+            if (c == '"') quoted += '"';
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+    std::vector<std::string> csv_split(const std::string& line) {
+        std::vector<std::string> fields(1);
+        bool in_quotes = false;
+        for (size_t i = 0; i < line.size(); ++i) {
+            char c = line[i];
+            if (in_quotes) {
+                if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                    fields.back() += '"';
+                    ++i;
+                } else if (c == '"') {
+                    in_quotes = false;
+                } else {
+                    fields.back() += c;
+                }
+            } else if (c == '"') {
+                in_quotes = true;
+            } else if (c == ',') {
+                fields.emplace_back();
+            } else if (c != '\r') {
+                fields.back() += c;
+            }
+        }
+        return fields;
+    }
+
+    std::string json_escape(const std::string& text) {
+        std::string escaped;
+        for (char c : text) {
+            switch (c) {
+                case '"': escaped += "\\\""; break;
+                case '\\': escaped += "\\\\"; break;
+                case '\n': escaped += "\\n"; break;
+                default: escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+    // One-sided 99% quantiles of Student's t for 1 to 30 degrees of freedom
+    const double T_TABLE[30] = {
+        31.821, 6.965, 4.541, 3.747, 3.365, 3.143, 2.998, 2.896, 2.821, 2.764,
+        2.718, 2.681, 2.650, 2.624, 2.602, 2.583, 2.567, 2.552, 2.539, 2.528,
+        2.518, 2.508, 2.500, 2.492, 2.485, 2.479, 2.473, 2.467, 2.462, 2.457,
+    };
+
+    // Student t critical value for the one-sided alpha above. The Cornish-Fisher
+    // expansion is far too low at small df (11.8 instead of 31.8 at df = 1), so up
+    // to 30 it is read from the table, at the df below for Welch's fractional df.
+    double t_critical(double df) {
+        if (df < 31.0) return T_TABLE[std::max(1, static_cast<int>(df)) - 1];
+        double z = Z_ALPHA;
+        double z3 = z * z * z;
+        double z5 = z3 * z * z;
+        return z + (z3 + z) / (4.0 * df) + (5.0 * z5 + 16.0 * z3 + 3.0 * z) / (96.0 * df * df);
+    }
+
+    const Measurement* find_measurement(const std::vector<Measurement>& measurements,
+                                        const Measurement& key) {
+        for (const auto& m : measurements) {
+            if (m.anthill_name == key.anthill_name && m.algorithm == key.algorithm) return &m;
+        }
+        return nullptr;
+    }
+}
+
+TimingStats TimingStats::from_samples(std::vector<double> samples_ms) {
+    TimingStats stats;
+    if (samples_ms.empty()) return stats;
+
+    std::sort(samples_ms.begin(), samples_ms.end());
+    size_t n = samples_ms.size();
+
+    double sum = 0.0;
+    for (double s : samples_ms) sum += s;
+
+    stats.samples = static_cast<int>(n);
+    stats.mean = sum / n;
+    stats.min = samples_ms.front();
+    stats.max = samples_ms.back();
+    stats.median = (n % 2 == 1) ? samples_ms[n / 2] : (samples_ms[n / 2 - 1] + samples_ms[n / 2]) / 2.0;
+    stats.p95 = samples_ms[static_cast<size_t>(std::ceil(0.95 * n)) - 1];
+
+    if (n > 1) {
+        double squares = 0.0;
+        for (double s : samples_ms) squares += (s - stats.mean) * (s - stats.mean);
+        stats.stddev = std::sqrt(squares / (n - 1));
+    }
+    return stats;
+}
+
+bool write_csv(const std::string& path, const std::vector<Measurement>& measurements) {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    bool first = true;
+    for (const char* column : CSV_COLUMNS) {
+        out << (first ? "" : ",") << column;
+        first = false;
+    }
+    out << "\n" << std::setprecision(6) << std::fixed;
+
+    for (const auto& m : measurements) {
+        out << csv_quote(m.anthill_name) << "," << csv_quote(m.algorithm) << ","
+            << m.steps << "," << m.expanded << "," << m.timing.samples << ","
+            << m.timing.mean << "," << m.timing.stddev << "," << m.timing.min << ","
+            << m.timing.median << "," << m.timing.p95 << "," << m.timing.max << ","
+            << m.perf.cycles << "," << m.perf.instructions << "," << m.perf.l1d_misses << ","
+            << m.perf.llc_misses << "," << m.perf.branch_misses << ","
+            << m.allocations << "," << m.bytes_allocated << "," << m.peak_rss_delta_kb << ","
+            << m.cache_hits << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+bool write_json(const std::string& path, const std::vector<Measurement>& measurements) {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    out << "[\n" << std::setprecision(6) << std::fixed;
+    for (size_t i = 0; i < measurements.size(); ++i) {
+        const Measurement& m = measurements[i];
+        out << "  {\"anthill\": \"" << json_escape(m.anthill_name) << "\", "
+            << "\"algorithm\": \"" << json_escape(m.algorithm) << "\", "
+            << "\"steps\": " << m.steps << ", "
+            << "\"expanded\": " << m.expanded << ", "
+            << "\"timing_ms\": {\"samples\": " << m.timing.samples
+            << ", \"mean\": " << m.timing.mean << ", \"stddev\": " << m.timing.stddev
+            << ", \"min\": " << m.timing.min << ", \"median\": " << m.timing.median
+            << ", \"p95\": " << m.timing.p95 << ", \"max\": " << m.timing.max << "}, "
+            << "\"counters\": {\"cycles\": " << m.perf.cycles
+            << ", \"instructions\": " << m.perf.instructions
+            << ", \"l1d_misses\": " << m.perf.l1d_misses
+            << ", \"llc_misses\": " << m.perf.llc_misses
+            << ", \"branch_misses\": " << m.perf.branch_misses << "}, "
+            << "\"memory\": {\"allocations\": " << m.allocations
+            << ", \"bytes_allocated\": " << m.bytes_allocated
+            << ", \"peak_rss_delta_kb\": " << m.peak_rss_delta_kb << "}, "
+            << "\"cache_hits\": " << m.cache_hits << "}"
+            << (i + 1 < measurements.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+    return static_cast<bool>(out);
+}
+
+bool read_csv(const std::string& path, std::vector<Measurement>& measurements, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    std::string line;
+    if (!std::getline(in, line)) {
+        error = path + " is empty";
+        return false;
+    }
+
+    // Columns are looked up by name so that files with extra columns still load
+    std::map<std::string, size_t> column_index;
+    std::vector<std::string> header = csv_split(line);
+    for (size_t i = 0; i < header.size(); ++i) column_index[header[i]] = i;
+    for (const char* column : CSV_COLUMNS) {
+        if (column_index.find(column) == column_index.end() && !is_optional_column(column)) {
+            error = path + ": missing column '" + column + "'";
+            return false;
+        }
+    }
+
+    int line_number = 1;
+    while (std::getline(in, line)) {
+        line_number++;
+        if (line.empty()) continue;
+
+        std::vector<std::string> fields = csv_split(line);
+        if (fields.size() != header.size()) {
+            error = path + ":" + std::to_string(line_number) + ": expected "
+                  + std::to_string(header.size()) + " fields";
+            return false;
+        }
+
+        auto field = [&](const char* name) -> const std::string& {
+            return fields[column_index[name]];
+        };
+        auto has_field = [&](const char* name) {
+            return column_index.find(name) != column_index.end();
+        };
+
+        try {
+            Measurement m;
+            m.anthill_name = field("anthill");
+            m.algorithm = field("algorithm");
+            m.steps = std::stoi(field("steps"));
+            m.expanded = std::stoll(field("expanded"));
+            m.timing.samples = std::stoi(field("samples"));
+            m.timing.mean = std::stod(field("mean_ms"));
+            m.timing.stddev = std::stod(field("stddev_ms"));
+            m.timing.min = std::stod(field("min_ms"));
+            m.timing.median = std::stod(field("median_ms"));
+            m.timing.p95 = std::stod(field("p95_ms"));
+            m.timing.max = std::stod(field("max_ms"));
+            m.perf.cycles = std::stoll(field("cycles"));
+            m.perf.instructions = std::stoll(field("instructions"));
+            m.perf.l1d_misses = std::stoll(field("l1d_misses"));
+            m.perf.llc_misses = std::stoll(field("llc_misses"));
+            m.perf.branch_misses = std::stoll(field("branch_misses"));
+            if (has_field("allocations")) m.allocations = std::stoll(field("allocations"));
+            if (has_field("bytes_allocated")) m.bytes_allocated = std::stoll(field("bytes_allocated"));
+            if (has_field("peak_rss_delta_kb")) m.peak_rss_delta_kb = std::stol(field("peak_rss_delta_kb"));
+            if (has_field("cache_hits")) m.cache_hits = std::stoi(field("cache_hits"));
+            measurements.push_back(m);
+        } catch (const std::exception&) {
+            error = path + ":" + std::to_string(line_number) + ": invalid number";
+            return false;
+        }
+    }
+    return true;
+}
+
+int compare_with_baseline(const std::vector<Measurement>& current,
+                          const std::vector<Measurement>& baseline,
+                          double threshold_pct) {
+    const int name_width = 30;
+    const int algo_width = 10;
+    const int value_width = 14;
+
+    std::cout << "\nComparison with baseline (slowdown > " << std::defaultfloat << threshold_pct
+              << "% and significant at 99%):\n";
+    std::cout << std::left
+              << std::setw(name_width) << "ANTHILL"
+              << std::setw(algo_width) << "ALGO"
+              << std::right
+              << std::setw(value_width) << "BASE (ms)"
+              << std::setw(value_width) << "NOW (ms)"
+              << std::setw(value_width) << "CHANGE"
+              << std::setw(value_width) << "STATUS"
+              << "\n" << std::string(92, '=') << "\n";
+
+    int regressions = 0;
+    for (const auto& now : current) {
+        const Measurement* base = find_measurement(baseline, now);
+        if (!base) continue;
+
+        double change_pct = base->timing.mean > 0.0
+            ? (now.timing.mean - base->timing.mean) / base->timing.mean * 100.0
+            : 0.0;
+
+        std::string status;
+        if (now.cache_hits > 0 || base->cache_hits > 0) {
+            status = "cached";  // Some runs timed a cache lookup, not the solver
+        } else if (now.timing.samples < 2 || base->timing.samples < 2) {
+            status = "n/a";
+        } else {
+            double var_now = now.timing.stddev * now.timing.stddev / now.timing.samples;
+            double var_base = base->timing.stddev * base->timing.stddev / base->timing.samples;
+            double diff = now.timing.mean - base->timing.mean;
+            bool significant;
+
+            if (var_now + var_base == 0.0) {
+                significant = diff > 0.0;
+            } else {
+                // Welch's t-test with Welch-Satterthwaite degrees of freedom
+                double t = diff / std::sqrt(var_now + var_base);
+                double df = (var_now + var_base) * (var_now + var_base)
+                          / (var_now * var_now / (now.timing.samples - 1)
+                             + var_base * var_base / (base->timing.samples - 1));
+                significant = t > t_critical(df);
+            }
+
+            if (significant && change_pct > threshold_pct) {
+                status = "SLOWER";
+                regressions++;
+            } else {
+                status = "ok";
+            }
+        }
+
+        std::cout << std::left << std::setw(name_width) << now.anthill_name
+                  << std::setw(algo_width) << now.algorithm
+                  << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(value_width) << base->timing.mean
+                  << std::setw(value_width) << now.timing.mean
+                  << std::setw(value_width - 1) << std::showpos << std::setprecision(1) << change_pct
+                  << std::noshowpos << "%"
+                  << std::setw(value_width) << status << "\n";
+    }
+
+    std::cout << "\n" << regressions << " significant slowdown(s) found.\n";
+    return regressions;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "perf_counters.h"
+
+// Wall time distribution over repeated runs of one solver, in milliseconds
+struct TimingStats {
+    int samples = 0;
+    double mean = 0.0;
+    double stddev = 0.0;  // Sample standard deviation (0 with a single sample)
+    double min = 0.0;
+    double median = 0.0;
+    double p95 = 0.0;
+    double max = 0.0;
+
+    static TimingStats from_samples(std::vector<double> samples_ms);
+};
+
+// One solver on one anthill
+struct Measurement {
+    std::string anthill_name;
+    std::string algorithm;
+    int steps = -1;
+    long long expanded = 0;  // Expanded nodes in a single run
+    TimingStats timing;
+    PerfSample perf;         // Mean counter values per run (-1 when unavailable)
+
+    // Memory footprint of a single run
+    long long allocations = 0;
+    long long bytes_allocated = 0;
+    long peak_rss_delta_kb = -1;  // Largest peak RSS growth over the runs (-1 when unavailable)
+
+    // Runs answered by the result cache (--cache): their time is a lookup, so
+    // compare_with_baseline does not test rows that have any
+    int cache_hits = 0;
+};
+
+// Writes every measurement as one CSV row (with a header line).
+// Returns false if the file could not be written.
+bool write_csv(const std::string& path, const std::vector<Measurement>& measurements);
+
+// Writes every measurement as a JSON array of objects.
+// Returns false if the file could not be written.
+bool write_json(const std::string& path, const std::vector<Measurement>& measurements);
+
+// Loads a file previously written by write_csv.
+// Returns false and fills error if the file is missing or malformed.
+bool read_csv(const std::string& path, std::vector<Measurement>& measurements, std::string& error);
+
+// Compares current measurements against a baseline, matched by anthill and algorithm.
+// A slowdown is flagged when Welch's t-test finds the mean time significantly higher
+// (one-sided, alpha = 0.01) and the relative slowdown exceeds threshold_pct. Rows
+// with cache hits on either side are shown as "cached" and never flagged.
+// Prints one line per matched measurement and returns the number of regressions.
+int compare_with_baseline(const std::vector<Measurement>& current,
+                          const std::vector<Measurement>& baseline,
+                          double threshold_pct);
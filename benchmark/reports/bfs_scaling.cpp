@@ -0,0 +1,47 @@
+#include "reports.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "ants.h"
+#include "room_hills.h"
+
+void print_bfs_scaling(int max_threads) {
+    std::vector<int> thread_counts;
+    for (int t = 1; t < max_threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+
+    const int value_width = 14;
+    for (const RoomHill& hill : {make_cave_hill(1000, 1000, 100, 7), make_random_hill(1000000, 8, 100, 7)}) {
+        Anthill anthill = hill.build<Anthill>();
+
+        std::cout << "\nDirection-optimizing BFS (" << hill.name << ", " << hill.tunnels.size() << " tunnels):\n";
+        std::cout << std::right
+                  << std::setw(value_width) << "THREADS"
+                  << std::setw(value_width) << "TIME (ms)"
+                  << std::setw(value_width) << "MTEPS"
+                  << std::setw(value_width) << "SPEEDUP"
+                  << std::setw(value_width) << "TOP-DOWN"
+                  << std::setw(value_width) << "BOTTOM-UP"
+                  << "\n" << std::string(6 * value_width, '=') << "\n";
+
+        double single_thread_ms = 0.0;
+        for (int threads : thread_counts) {
+            auto start = std::chrono::high_resolution_clock::now();
+            BfsTraversal traversal = anthill.room_distances(threads);
+            auto end = std::chrono::high_resolution_clock::now();
+            double time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+            if (threads == 1) single_thread_ms = time_ms;
+
+            std::cout << std::setw(value_width) << threads
+                      << std::setw(value_width) << std::fixed << std::setprecision(3) << time_ms
+                      << std::setw(value_width) << std::setprecision(1)
+                      << traversal.traversed_edges / (time_ms * 1000.0)
+                      << std::setw(value_width - 1) << std::setprecision(2) << single_thread_ms / time_ms << "x"
+                      << std::setw(value_width) << traversal.top_down_levels
+                      << std::setw(value_width) << traversal.bottom_up_levels << "\n";
+        }
+    }
+    std::cout << std::defaultfloat;
+}
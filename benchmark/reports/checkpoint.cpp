@@ -0,0 +1,123 @@
+#include "reports.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "ants_dijkstra.h"
+#include "room_hills.h"
+#include "simulation_checkpoint.h"
+
+void print_checkpoint_report(const std::string& path, int interval) {
+    RoomHill cave = make_cave_hill(400, 100, 1000000, 5);
+    AnthillDijkstra anthill = cave.build<AnthillDijkstra>();
+    anthill.set_verbose(false);
+    const SimulationStepper fresh = anthill.disjoint_simulation(8);
+
+    auto same_end = [](const SimulationStepper& a, const SimulationStepper& b) {
+        return a.done() && b.done() && a.result() == b.result() && a.steps() == b.steps()
+               && a.arrived() == b.arrived() && a.occupancy() == b.occupancy();
+    };
+
+    SimulationStepper reference = fresh;
+    auto start = std::chrono::high_resolution_clock::now();
+    while (reference.advance()) {}
+    auto end = std::chrono::high_resolution_clock::now();
+    double plain_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    // A finished run, or one of another cave or colony, is left alone: resuming it
+    // would time nothing, or compare two different simulations
+    std::string error;
+    SimulationStepper resumed;
+    int resumed_at = -1;
+    double resumed_ms = 0.0;
+    std::string not_resumed;
+    if (load_checkpoint(path, resumed, error)) {
+        if (resumed.done()) {
+            not_resumed = "it holds a finished run";
+        } else if (resumed.routes() != fresh.routes() || resumed.capacities() != fresh.capacities()
+                   || resumed.ants() != fresh.ants()) {
+            not_resumed = "it holds another simulation";
+        } else {
+            resumed_at = resumed.steps();
+            CheckpointStats resumed_stats;
+            start = std::chrono::high_resolution_clock::now();
+            if (!run_with_checkpoints(resumed, path, interval, resumed_stats, error)) {
+                std::cerr << "Checkpoint failed: " << error << "\n";
+                return;
+            }
+            end = std::chrono::high_resolution_clock::now();
+            resumed_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        }
+    } else if (std::filesystem::exists(path)) {
+        not_resumed = error;
+    }
+
+    SimulationStepper checkpointed = fresh;
+    CheckpointStats stats;
+    start = std::chrono::high_resolution_clock::now();
+    if (!run_with_checkpoints(checkpointed, path, interval, stats, error)) {
+        std::cerr << "Checkpoint failed: " << error << "\n";
+        return;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double checkpointed_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    // Stop halfway, write a checkpoint, and finish the run from the file alone
+    SimulationStepper halfway = fresh;
+    while (halfway.steps() < reference.steps() / 2 && halfway.advance()) {}
+    std::string halfway_path = path + ".half";
+    SimulationStepper restored;
+    bool restored_ok = save_checkpoint(halfway, halfway_path, error) && load_checkpoint(halfway_path, restored, error);
+    std::filesystem::remove(halfway_path);
+    if (restored_ok) {
+        while (restored.advance()) {}
+    }
+
+    const int value_width = 14;
+    std::cout << "\nCheckpointed simulation (" << cave.name << ", " << fresh.ants() << " ants, "
+              << fresh.routes().size() << " routes, every " << interval << " steps):\n";
+    if (resumed_at >= 0) std::cout << "Resumed from " << path << " at step " << resumed_at << "\n";
+    if (!not_resumed.empty()) std::cout << "Not resuming " << path << ": " << not_resumed << "\n";
+    std::cout << std::right
+              << std::setw(value_width) << "RUN"
+              << std::setw(value_width) << "STEPS"
+              << std::setw(value_width) << "TIME (ms)"
+              << std::setw(value_width) << "CHECKPOINTS"
+              << std::setw(value_width) << "SIZE (KB)"
+              << std::setw(value_width) << "WRITE (ms)"
+              << std::setw(value_width) << "MAX (ms)"
+              << std::setw(value_width) << "SAME RESULT"
+              << "\n" << std::string(8 * value_width, '=') << "\n";
+    std::cout << std::setw(value_width) << "plain"
+              << std::setw(value_width) << reference.steps()
+              << std::setw(value_width) << std::fixed << std::setprecision(3) << plain_ms
+              << std::setw(value_width) << "-" << std::setw(value_width) << "-"
+              << std::setw(value_width) << "-" << std::setw(value_width) << "-"
+              << std::setw(value_width) << "-" << "\n";
+    std::cout << std::setw(value_width) << "checkpointed"
+              << std::setw(value_width) << checkpointed.steps()
+              << std::setw(value_width) << checkpointed_ms
+              << std::setw(value_width) << stats.checkpoints
+              << std::setw(value_width) << std::setprecision(1) << stats.last_bytes / 1024.0
+              << std::setw(value_width) << std::setprecision(3) << stats.total_ms / std::max(1, stats.checkpoints)
+              << std::setw(value_width) << stats.max_ms
+              << std::setw(value_width) << (same_end(checkpointed, reference) ? "yes" : "NO") << "\n";
+    if (resumed_at >= 0) {
+        std::cout << std::setw(value_width) << "resumed"
+                  << std::setw(value_width) << resumed.steps()
+                  << std::setw(value_width) << resumed_ms
+                  << std::setw(value_width) << "-" << std::setw(value_width) << "-"
+                  << std::setw(value_width) << "-" << std::setw(value_width) << "-"
+                  << std::setw(value_width) << (same_end(resumed, reference) ? "yes" : "NO") << "\n";
+    }
+    std::cout << std::setw(value_width) << "from halfway"
+              << std::setw(value_width) << restored.steps()
+              << std::setw(value_width) << "-" << std::setw(value_width) << 1
+              << std::setw(value_width) << "-" << std::setw(value_width) << "-" << std::setw(value_width) << "-"
+              << std::setw(value_width) << (restored_ok && same_end(restored, reference) ? "yes" : "NO") << "\n";
+    std::cout << "Checkpoint overhead: " << std::setprecision(1)
+              << 100.0 * stats.total_ms / std::max(1e-9, checkpointed_ms) << "% of the checkpointed run\n"
+              << "Last checkpoint kept in " << path << "\n" << std::defaultfloat;
+}
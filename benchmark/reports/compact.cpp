@@ -0,0 +1,75 @@
+#include "reports.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "ants.h"
+#include "compact_graph.h"
+#include "hpa_star.h"
+#include "room_hills.h"
+#include "search_core.h"
+
+void print_compact_report() {
+    const int value_width = 14;
+    std::cout << "\nCompact hill storage (BFS, start to dormitory, best of 5):\n";
+    std::cout << std::right
+              << std::setw(32) << "HILL"
+              << std::setw(value_width) << "STORAGE"
+              << std::setw(value_width) << "MEMORY (MB)"
+              << std::setw(value_width) << "TIME (ms)"
+              << std::setw(value_width) << "SPEEDUP"
+              << std::setw(value_width) << "SAME ROUTE"
+              << "\n" << std::string(32 + 5 * value_width, '=') << "\n";
+
+    for (const RoomHill& hill : {make_cave_hill(250, 250, 100, 7), make_cave_hill(1000, 1000, 100, 7),
+                                 make_random_hill(1000000, 8, 100, 7)}) {
+        std::vector<std::vector<int>> rooms = hill.adjacency();
+        const int goal = hill.rooms() - 1;
+        BfsWorkspace workspace;
+
+        auto best_of = [&](const auto& graph, std::vector<int>& path, int& steps) {
+            double best_ms = 0.0;
+            for (int run = 0; run < 5; run++) {
+                auto start = std::chrono::high_resolution_clock::now();
+                steps = best_first_search(graph, 0, goal, workspace, &path);
+                auto end = std::chrono::high_resolution_clock::now();
+                double time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+                if (run == 0 || time_ms < best_ms) best_ms = time_ms;
+            }
+            return best_ms;
+        };
+
+        size_t list_bytes = rooms.capacity() * sizeof(rooms[0]);
+        for (const std::vector<int>& neighbors : rooms) list_bytes += neighbors.capacity() * sizeof(int);
+        std::vector<int> list_path;
+        int list_steps = 0;
+        double list_ms = best_of(AdjacencyList(rooms), list_path, list_steps);
+
+        std::vector<int> compact_path;
+        int compact_steps = 0;
+        size_t compact_bytes = 0;
+        double compact_ms = with_compact_graph(rooms, [&](const auto& graph) {
+            compact_bytes = graph.memory_bytes();
+            return best_of(graph, compact_path, compact_steps);
+        });
+        bool same = compact_steps == list_steps && compact_path == list_path;
+
+        std::cout << std::setw(32) << hill.name
+                  << std::setw(value_width) << "lists"
+                  << std::setw(value_width) << std::fixed << std::setprecision(1) << list_bytes / 1048576.0
+                  << std::setw(value_width) << std::setprecision(3) << list_ms
+                  << std::setw(value_width) << "-"
+                  << std::setw(value_width) << "-" << "\n";
+        std::cout << std::setw(32) << ""
+                  << std::setw(value_width) << "csr u" + std::to_string(8 * compact_index_bytes(rooms.size()))
+                  << std::setw(value_width) << std::setprecision(1) << compact_bytes / 1048576.0
+                  << std::setw(value_width) << std::setprecision(3) << compact_ms
+                  << std::setw(value_width - 1) << std::setprecision(2) << list_ms / compact_ms << "x"
+                  << std::setw(value_width) << (same ? "yes" : "NO") << "\n";
+    }
+
+    GridMap map = make_random_map(2048, 0.2, 7);
+    std::cout << "2048x2048 grid: " << std::setprecision(1) << map.memory_bytes() / 1024.0 << " KB of wall bits, "
+              << static_cast<size_t>(map.size()) / 1024 << " KB at a byte per cell\n" << std::defaultfloat;
+}
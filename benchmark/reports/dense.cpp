@@ -0,0 +1,83 @@
+#include "reports.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+#include "ants.h"
+#include "ants_dijkstra.h"
+#include "room_hills.h"
+#include "search_core.h"
+#include "tunnel_set.h"
+
+void print_dense_report() {
+    RoomHill hill = make_random_hill(2000, 2000, 100, 7);
+    const int queries = 1000000;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    AnthillDijkstra anthill = hill.build<AnthillDijkstra>();
+    auto end = std::chrono::high_resolution_clock::now();
+    double build_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    // The lists the solvers held before, and the ones add_tunnels now builds
+    std::vector<std::vector<int>> listed = hill.adjacency();
+    std::vector<std::vector<int>> deduplicated(hill.rooms());
+    TunnelSet seen;
+    for (const auto& [a, b] : hill.tunnels) {
+        if (seen.insert(a, b)) {
+            deduplicated[a].push_back(b);
+            deduplicated[b].push_back(a);
+        }
+    }
+    size_t kept = seen.size();
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> any_room(0, hill.rooms() - 1);
+    std::vector<std::pair<int, int>> pairs(queries);
+    for (auto& pair : pairs) pair = {any_room(rng), any_room(rng)};
+
+    long long found = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (const auto& [a, b] : pairs) found += anthill.has_tunnel(a, b);
+    end = std::chrono::high_resolution_clock::now();
+    double indexed_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    long long scanned = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (const auto& [a, b] : pairs) scanned += std::find(listed[a].begin(), listed[a].end(), b) != listed[a].end();
+    end = std::chrono::high_resolution_clock::now();
+    double scan_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    BfsWorkspace workspace;
+    std::vector<int> path;
+    auto bfs_ms = [&](const std::vector<std::vector<int>>& rooms, int& steps) {
+        double best_ms = 0.0;
+        for (int run = 0; run < 5; run++) {
+            start = std::chrono::high_resolution_clock::now();
+            steps = 0;
+            for (int goal = 1; goal < hill.rooms(); goal += hill.rooms() / 16) {
+                steps += best_first_search(AdjacencyList(rooms), 0, goal, workspace, &path);
+            }
+            end = std::chrono::high_resolution_clock::now();
+            double time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+            if (run == 0 || time_ms < best_ms) best_ms = time_ms;
+        }
+        return best_ms;
+    };
+    int listed_steps = 0;
+    int deduplicated_steps = 0;
+    double listed_bfs_ms = bfs_ms(listed, listed_steps);
+    double deduplicated_bfs_ms = bfs_ms(deduplicated, deduplicated_steps);
+
+    std::cout << "\nDense hill (" << hill.name << ", " << hill.tunnels.size() << " tunnels listed):\n"
+              << "  bulk build:      " << std::fixed << std::setprecision(1) << build_ms << " ms, "
+              << kept << " tunnels kept, " << hill.tunnels.size() - kept << " duplicates refused\n"
+              << "  has_tunnel:      " << std::setprecision(1) << indexed_ms * 1e6 / queries << " ns per lookup, against "
+              << scan_ms * 1e6 / queries << " ns scanning the lists (" << (found == scanned ? "same answers" : "ANSWERS DIFFER")
+              << ")\n"
+              << "  16 BFS searches: " << std::setprecision(3) << deduplicated_bfs_ms << " ms without duplicates, "
+              << listed_bfs_ms << " ms with them (" << (listed_steps == deduplicated_steps ? "same routes" : "ROUTES DIFFER")
+              << ")\n" << std::defaultfloat;
+}
@@ -0,0 +1,85 @@
+#include "reports.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "hpa_star.h"
+
+void print_hpa_report(int map_size, int cluster_size) {
+    const int queries = 20;
+    GridMap map = make_random_map(map_size, 0.2, 7);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    HierarchicalMap hierarchy(map, cluster_size);
+    auto end = std::chrono::high_resolution_clock::now();
+    double preprocessing_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> any_cell(0, map.rows() * map.cols() - 1);
+    auto random_open_cell = [&]() {
+        int cell = any_cell(rng);
+        while (!map.open(cell)) cell = any_cell(rng);
+        return cell;
+    };
+
+    DijkstraWorkspace workspace;
+    double flat_ms = 0.0, route_ms = 0.0, refine_ms = 0.0;
+    long long flat_expanded = 0, abstract_expanded = 0, flat_steps = 0, hpa_steps = 0;
+    int solved = 0;
+    for (int q = 0; q < queries; q++) {
+        int from = random_open_cell();
+        int to = random_open_cell();
+
+        start = std::chrono::high_resolution_clock::now();
+        int flat_length = flat_astar(map, from, to, workspace, nullptr, &flat_expanded);
+        end = std::chrono::high_resolution_clock::now();
+        flat_ms += std::chrono::duration<double, std::milli>(end - start).count();
+
+        start = std::chrono::high_resolution_clock::now();
+        HierarchicalMap::Route route = hierarchy.find_route(from, to, &abstract_expanded);
+        end = std::chrono::high_resolution_clock::now();
+        route_ms += std::chrono::duration<double, std::milli>(end - start).count();
+
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<int> cells = hierarchy.refine(route);
+        end = std::chrono::high_resolution_clock::now();
+        refine_ms += std::chrono::duration<double, std::milli>(end - start).count();
+
+        if (flat_length > 0 && route.length > 0) {
+            solved++;
+            flat_steps += flat_length;
+            hpa_steps += route.length;
+        }
+    }
+
+    const int value_width = 16;
+    std::cout << "\nHPA* vs flat A* (" << map_size << "x" << map_size << " map, clusters of "
+              << cluster_size << ", " << queries << " queries):\n";
+    std::cout << "Preprocessing: " << std::fixed << std::setprecision(1) << preprocessing_ms << " ms, "
+              << hierarchy.abstract_nodes() << " entrances, " << hierarchy.abstract_edges() << " edges\n";
+    std::cout << std::right
+              << std::setw(value_width) << "METHOD"
+              << std::setw(value_width) << "MEMORY (KB)"
+              << std::setw(value_width) << "QUERY (ms)"
+              << std::setw(value_width) << "EXPANDED"
+              << "\n" << std::string(4 * value_width, '=') << "\n";
+    std::cout << std::setw(value_width) << "Flat A*"
+              << std::setw(value_width) << std::setprecision(1) << workspace.memory_bytes() / 1024.0
+              << std::setw(value_width) << std::setprecision(3) << flat_ms / queries
+              << std::setw(value_width) << flat_expanded / queries << "\n";
+    std::cout << std::setw(value_width) << "HPA*"
+              << std::setw(value_width) << std::setprecision(1) << hierarchy.memory_bytes() / 1024.0
+              << std::setw(value_width) << std::setprecision(3) << route_ms / queries
+              << std::setw(value_width) << abstract_expanded / queries << "\n";
+    std::cout << std::setw(value_width) << "HPA* + refine"
+              << std::setw(value_width) << "-"
+              << std::setw(value_width) << std::setprecision(3) << (route_ms + refine_ms) / queries
+              << std::setw(value_width) << "-" << "\n";
+    if (solved > 0) {
+        std::cout << "HPA* routes are " << std::setprecision(2)
+                  << 100.0 * (hpa_steps - flat_steps) / flat_steps << "% longer than optimal on average\n";
+    }
+    std::cout << std::defaultfloat;
+}
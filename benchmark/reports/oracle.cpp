@@ -0,0 +1,82 @@
+#include "reports.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "ants.h"
+#include "ants_astar.h"
+#include "ants_dijkstra.h"
+#include "makespan_flow.h"
+#include "room_hills.h"
+
+void print_oracle_report() {
+    const int value_width = 12;
+    const int label_width = 32;
+    bool below_optimal = false;
+    auto cell = [&](int steps, int optimal) {
+        std::ostringstream text;
+        if (steps < 0) {
+            text << "-";
+        } else {
+            text << steps;
+        }
+        if (steps >= 0 && steps < optimal) {
+            text << "*";
+            below_optimal = true;
+        }
+        std::cout << std::setw(value_width) << text.str();
+    };
+
+    std::cout << "\nSteps against the optimal makespan (time-expanded max flow):\n";
+    std::cout << std::left << std::setw(label_width) << "ANTHILL" << std::right
+              << std::setw(value_width) << "OPTIMAL"
+              << std::setw(value_width) << "BFS"
+              << std::setw(value_width) << "A*"
+              << std::setw(value_width) << "DIJKSTRA"
+              << std::setw(value_width) << "DISJOINT"
+              << std::setw(value_width) << "WIDEST"
+              << "\n" << std::string(label_width + 6 * value_width, '=') << "\n";
+
+    for (const RoomHill& hill : room_hills()) {
+        int optimal = minimum_makespan(hill.adjacency(), hill.capacities, 0, hill.rooms() - 1, hill.ants);
+
+        auto bfs = hill.build<Anthill>();
+        auto astar = hill.build<AnthillAStar>();
+        auto dijkstra = hill.build<AnthillDijkstra>();
+        bfs.set_verbose(false);
+        astar.set_verbose(false);
+        dijkstra.set_verbose(false);
+
+        std::cout << std::left << std::setw(label_width) << hill.name << std::right;
+        cell(optimal, optimal);
+        cell(bfs.simulate_dfs(), optimal);
+        cell(astar.simulate_astar(), optimal);
+        cell(dijkstra.simulate_dijkstra(), optimal);
+        cell(dijkstra.simulate_dijkstra_disjoint(4), optimal);
+        cell(dijkstra.simulate_dijkstra_widest(), optimal);
+        std::cout << "\n";
+    }
+    if (below_optimal) {
+        std::cout << "* below the optimum: that simulation lets an ant take more than one tunnel per step\n";
+    }
+
+    // Oracle cost on a hill far bigger than the hand-built ones
+    RoomHill cave = make_cave_hill(40, 8, 2000, 42);
+    MakespanStats stats;
+    auto start = std::chrono::high_resolution_clock::now();
+    int optimal = minimum_makespan(cave.adjacency(), cave.capacities, 0, cave.rooms() - 1, cave.ants, &stats);
+    auto end = std::chrono::high_resolution_clock::now();
+    double time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    auto dijkstra = cave.build<AnthillDijkstra>();
+    dijkstra.set_verbose(false);
+
+    std::cout << "\n" << cave.name << ", " << cave.ants << " ants:\n"
+              << "  optimal makespan:  " << optimal << " steps\n"
+              << "  Dijkstra disjoint: " << dijkstra.simulate_dijkstra_disjoint(8) << " steps\n"
+              << "  oracle time:       " << std::fixed << std::setprecision(3) << time_ms << " ms ("
+              << stats.flow_checks << " max-flow runs, largest network "
+              << stats.largest_nodes << " nodes / " << stats.largest_arcs << " arcs)\n";
+    std::cout << std::defaultfloat;
+}
@@ -0,0 +1,69 @@
+#include "reports.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "parallel_paths.h"
+
+namespace {
+    // Braided corridor: `layers` layers of `width` rooms, each room linked to the same and
+    // the next room of the following layer. Room 0 is the start, the last room the dormitory.
+    // The number of simple paths grows exponentially with the number of layers.
+    std::vector<std::vector<int>> make_braided_hill(int layers, int width) {
+        int total_rooms = layers * width + 2;
+        std::vector<std::vector<int>> graph(total_rooms);
+        auto room = [width](int layer, int i) { return 1 + layer * width + i; };
+        auto add_tunnel = [&graph](int a, int b) {
+            graph[a].push_back(b);
+            graph[b].push_back(a);
+        };
+
+        for (int i = 0; i < width; i++) {
+            add_tunnel(0, room(0, i));
+            add_tunnel(room(layers - 1, i), total_rooms - 1);
+        }
+        for (int layer = 0; layer + 1 < layers; layer++) {
+            for (int i = 0; i < width; i++) {
+                add_tunnel(room(layer, i), room(layer + 1, i));
+                add_tunnel(room(layer, i), room(layer + 1, (i + 1) % width));
+            }
+        }
+        return graph;
+    }
+}
+
+void print_path_scaling(int max_threads) {
+    const int layers = 8;
+    const int width = 3;
+    std::vector<std::vector<int>> graph = make_braided_hill(layers, width);
+    int end_room = static_cast<int>(graph.size()) - 1;
+
+    std::vector<int> thread_counts;
+    for (int t = 1; t < max_threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+
+    const int value_width = 16;
+    std::cout << "\nParallel path enumeration (braided hill, " << graph.size() << " rooms):\n";
+    std::cout << std::right
+              << std::setw(value_width) << "THREADS"
+              << std::setw(value_width) << "PATHS"
+              << std::setw(value_width) << "TIME (ms)"
+              << std::setw(value_width) << "SPEEDUP"
+              << "\n" << std::string(64, '=') << "\n";
+
+    double single_thread_ms = 0.0;
+    for (int threads : thread_counts) {
+        auto start = std::chrono::high_resolution_clock::now();
+        size_t paths = enumerate_paths_parallel(graph, 0, end_room, threads).size();
+        auto end = std::chrono::high_resolution_clock::now();
+        double time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (threads == 1) single_thread_ms = time_ms;
+
+        std::cout << std::setw(value_width) << threads
+                  << std::setw(value_width) << paths
+                  << std::setw(value_width) << std::fixed << std::setprecision(3) << time_ms
+                  << std::setw(value_width - 1) << std::setprecision(2) << single_thread_ms / time_ms << "x"
+                  << "\n";
+    }
+}
@@ -0,0 +1,82 @@
+#include "reports.h"
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ants.h"
+#include "ants_astar.h"
+#include "ants_dijkstra.h"
+#include "room_hills.h"
+
+void print_reachability_report() {
+    RoomHill cut = make_cave_hill(12, 4, 100, 3);
+    const int dormitory = cut.rooms() - 1;
+    cut.tunnels.erase(std::remove_if(cut.tunnels.begin(), cut.tunnels.end(),
+                                     [dormitory](const std::pair<int, int>& tunnel) {
+                                         return tunnel.first == dormitory || tunnel.second == dormitory;
+                                     }),
+                      cut.tunnels.end());
+
+    Anthill bfs = cut.build<Anthill>();
+    AnthillAStar astar = cut.build<AnthillAStar>();
+    AnthillDijkstra dijkstra = cut.build<AnthillDijkstra>();
+    bfs.set_verbose(false);
+    astar.set_verbose(false);
+    dijkstra.set_verbose(false);
+
+    const std::vector<std::pair<std::string, std::function<int()>>> solvers = {
+        {"simulate_dfs", [&]() { return bfs.simulate_dfs(); }},
+        {"simulate_top_paths(4)", [&]() { return bfs.simulate_top_paths(4); }},
+        {"simulate_astar", [&]() { return astar.simulate_astar(); }},
+        {"simulate_dijkstra", [&]() { return dijkstra.simulate_dijkstra(); }},
+        {"disjoint(8)", [&]() { return dijkstra.simulate_dijkstra_disjoint(8); }},
+        {"widest", [&]() { return dijkstra.simulate_dijkstra_widest(); }},
+    };
+
+    const int value_width = 14;
+    std::cout << "\nUnreachable dormitory (" << cut.name << ", dormitory cut off):\n";
+    std::cout << std::right << std::setw(24) << "SOLVER"
+              << std::setw(value_width) << "RESULT"
+              << std::setw(value_width) << "TIME (us)"
+              << "\n" << std::string(24 + 2 * value_width, '=') << "\n";
+    for (const auto& [name, simulate] : solvers) {
+        auto start = std::chrono::high_resolution_clock::now();
+        int result = simulate();
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << std::setw(24) << name
+                  << std::setw(value_width) << result
+                  << std::setw(value_width) << std::fixed << std::setprecision(2)
+                  << std::chrono::duration<double, std::micro>(end - start).count() << "\n";
+    }
+
+    // The dormitory's component is asked about after every tunnel, as a loader
+    // streaming a hill in would
+    RoomHill hill = make_random_hill(1000000, 8, 100, 7);
+    auto start = std::chrono::high_resolution_clock::now();
+    Anthill streamed(hill.rooms(), hill.ants);
+    long long joined_at = -1;
+    for (size_t t = 0; t < hill.tunnels.size(); t++) {
+        streamed.add_tunnels(hill.tunnels[t].first, hill.tunnels[t].second);
+        if (joined_at < 0 && streamed.dormitory_reachable()) joined_at = static_cast<long long>(t) + 1;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double stream_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    std::vector<std::vector<int>> plain(hill.rooms());
+    for (const auto& [a, b] : hill.tunnels) {
+        plain[a].push_back(b);
+        plain[b].push_back(a);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double lists_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::cout << hill.name << ", " << hill.tunnels.size() << " tunnels streamed in: "
+              << std::setprecision(1) << stream_ms << " ms with a reachability query after each ("
+              << lists_ms << " ms for the adjacency lists alone); dormitory reachable after tunnel "
+              << joined_at << ", " << streamed.connectivity().components() << " components at the end\n"
+              << std::defaultfloat;
+}
@@ -0,0 +1,77 @@
+#include "reports.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "ants_dijkstra.h"
+#include "room_hills.h"
+
+void print_replan_report() {
+    const int changes = 12;
+    RoomHill cave = make_cave_hill(1000, 1000, 100, 7);
+    AnthillDijkstra anthill = cave.build<AnthillDijkstra>();
+    std::mt19937 rng(7);
+
+    std::vector<int> route;
+    auto start = std::chrono::high_resolution_clock::now();
+    anthill.replan(route);
+    auto end = std::chrono::high_resolution_clock::now();
+    double first_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    const int value_width = 14;
+    std::cout << "\nIncremental replanning (" << cave.name << ", first search "
+              << std::fixed << std::setprecision(1) << first_ms << " ms):\n";
+    std::cout << std::right
+              << std::setw(value_width) << "CHANGE"
+              << std::setw(value_width) << "LPA* ROOMS"
+              << std::setw(value_width) << "FULL ROOMS"
+              << std::setw(value_width) << "LPA* (ms)"
+              << std::setw(value_width) << "FULL (ms)"
+              << std::setw(value_width) << "SAME DIST"
+              << "\n" << std::string(6 * value_width, '=') << "\n";
+
+    DijkstraWorkspace workspace;
+    std::vector<int> full_route;
+    for (int change = 0; change < changes && route.size() > 2; change++) {
+        std::string kind;
+        std::uniform_int_distribution<size_t> on_route(1, route.size() - 2);
+        if (change % 3 == 0) {
+            size_t i = on_route(rng);
+            anthill.remove_tunnel(route[i], route[i + 1]);
+            kind = "collapse";
+        } else if (change % 3 == 1) {
+            anthill.set_room_capacity(route[on_route(rng)], 1);
+            kind = "capacity";
+        } else {
+            // A shortcut from a room to one at least two further down the route, so
+            // never a room to itself or the next one. add_tunnels refuses a tunnel
+            // already dug, which is then no change at all.
+            std::uniform_int_distribution<size_t> before_last(0, route.size() - 3);
+            size_t i = before_last(rng);
+            bool dug = anthill.add_tunnels(route[i], route[std::min(route.size() - 1, i + 5)]);
+            kind = dug ? "new tunnel" : "no change";
+        }
+
+        long long incremental_rooms = 0, full_rooms = 0;
+        start = std::chrono::high_resolution_clock::now();
+        int distance = anthill.replan(route, &incremental_rooms);
+        end = std::chrono::high_resolution_clock::now();
+        double incremental_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        start = std::chrono::high_resolution_clock::now();
+        int full_distance = anthill.find_best_path(workspace, full_route, &full_rooms);
+        end = std::chrono::high_resolution_clock::now();
+        double full_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        std::cout << std::setw(value_width) << kind
+                  << std::setw(value_width) << incremental_rooms
+                  << std::setw(value_width) << full_rooms
+                  << std::setw(value_width) << std::setprecision(3) << incremental_ms
+                  << std::setw(value_width) << full_ms
+                  << std::setw(value_width) << (distance == full_distance ? "yes" : "NO") << "\n";
+    }
+    std::cout << std::defaultfloat;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+
+// Optional reports of the benchmark, one per flag, each in the file of this
+// directory named after its feature. They print their tables to std::cout.
+
+// Times full simple-path enumeration with 1, 2, 4, ... threads up to max_threads
+void print_path_scaling(int max_threads);
+
+// Optimality gap of the room solvers: the exact minimum makespan from the
+// time-expanded flow, next to the steps each heuristic simulation takes
+void print_oracle_report();
+
+// Times delta-stepping on 1, 2, 4, ... threads up to max_threads against the
+// sequential Dijkstra of the same solver, on a generated hill of a million rooms
+void print_sssp_scaling(int max_threads, int delta);
+
+// Traversed edges per second of the direction-optimizing BFS on 1, 2, 4, ... threads
+// up to max_threads, on a million-room cave (long and thin) and random hill (wide)
+void print_bfs_scaling(int max_threads);
+
+// BFS from the start to the dormitory over the solvers' adjacency lists against
+// the same search over a CompactGraph, whose id width is picked from the hill size,
+// then the bytes per cell of a bit-packed GridMap
+void print_compact_report();
+
+// Time for each solver to give up on a cave whose dormitory has lost its tunnels,
+// now answered from the connectivity kept by add_tunnels instead of by searching;
+// then the cost of that bookkeeping while the tunnels of a large hill stream in
+void print_reachability_report();
+
+// Dense hill whose random tunnels repeat: bulk build with duplicates refused,
+// has_tunnel against a scan of the adjacency lists, and a BFS over the
+// deduplicated lists against one over every tunnel as listed
+void print_dense_report();
+
+// HPA* against flat A* on a random map of map_size cells a side: preprocessing time,
+// abstract graph size and memory, then per-query latency over random start/goal pairs
+void print_hpa_report(int map_size, int cluster_size);
+
+// Incremental repair (LPA*) against a full Dijkstra after each change to a
+// million-room cave: tunnels of the current route collapsing, capacities
+// changing, new tunnels being dug
+void print_replan_report();
+
+// Cost of recording a binary trace (--trace FILE) against the same simulations run
+// headless, the size of the delta-encoded trace, and the time to open it and seek
+// to its middle step as the replay tool does
+void print_trace_report(const std::string& path);
+
+// Many small simulations stepped together by SimulationScheduler, against playing
+// them one after the other; then the same runs stopped as soon as half the colony
+// has arrived, which the run-to-completion simulate_* functions cannot do
+void print_stepping_report(int count, int max_threads);
+
+// A long disjoint-route simulation checkpointed every `interval` steps from its
+// first step, against the same run without checkpoints. If path holds an
+// unfinished checkpoint of this same simulation (a run that was stopped), it is
+// finished first on a row of its own. A run restored from a checkpoint taken
+// halfway must end exactly like the uninterrupted one.
+void print_checkpoint_report(const std::string& path, int interval);
@@ -0,0 +1,52 @@
+#include "reports.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "ants_dijkstra.h"
+#include "room_hills.h"
+
+void print_sssp_scaling(int max_threads, int delta) {
+    RoomHill cave = make_cave_hill(1000, 1000, 100, 7);
+    AnthillDijkstra anthill = cave.build<AnthillDijkstra>();
+
+    std::vector<int> thread_counts;
+    for (int t = 1; t < max_threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+
+    DijkstraWorkspace workspace;
+    std::vector<int> sequential_path;
+    auto start = std::chrono::high_resolution_clock::now();
+    int sequential_distance = anthill.find_best_path(workspace, sequential_path);
+    auto end = std::chrono::high_resolution_clock::now();
+    double sequential_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    const int value_width = 16;
+    std::cout << "\nDelta-stepping shortest paths (" << cave.name << ", delta " << delta << "):\n";
+    std::cout << std::right
+              << std::setw(value_width) << "THREADS"
+              << std::setw(value_width) << "TIME (ms)"
+              << std::setw(value_width) << "SPEEDUP"
+              << std::setw(value_width) << "SAME ROUTE"
+              << "\n" << std::string(64, '=') << "\n";
+    std::cout << std::setw(value_width) << "Dijkstra"
+              << std::setw(value_width) << std::fixed << std::setprecision(3) << sequential_ms
+              << std::setw(value_width - 1) << std::setprecision(2) << 1.0 << "x"
+              << std::setw(value_width) << "-" << "\n";
+
+    for (int threads : thread_counts) {
+        std::vector<int> path;
+        start = std::chrono::high_resolution_clock::now();
+        int distance = anthill.find_best_path_parallel(path, delta, threads);
+        end = std::chrono::high_resolution_clock::now();
+        double time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        bool same = distance == sequential_distance && path == sequential_path;
+
+        std::cout << std::setw(value_width) << threads
+                  << std::setw(value_width) << std::setprecision(3) << time_ms
+                  << std::setw(value_width - 1) << std::setprecision(2) << sequential_ms / time_ms << "x"
+                  << std::setw(value_width) << (same ? "yes" : "NO") << "\n";
+    }
+    std::cout << std::defaultfloat;
+}
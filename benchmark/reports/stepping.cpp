@@ -0,0 +1,93 @@
+#include "reports.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "ants_dijkstra.h"
+#include "room_hills.h"
+#include "simulation_scheduler.h"
+
+void print_stepping_report(int count, int max_threads) {
+    std::vector<int> thread_counts;
+    for (int t = 1; t < max_threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+
+    // Route searches happen here, once: only the stepping is timed below
+    std::vector<SimulationStepper> simulations;
+    std::vector<int> expected;
+    for (int i = 0; i < count; i++) {
+        RoomHill cave = make_cave_hill(20 + i % 5 * 4, 8, 200 + i % 7 * 50, static_cast<unsigned>(i));
+        AnthillDijkstra anthill = cave.build<AnthillDijkstra>();
+        anthill.set_verbose(false);
+        simulations.push_back(anthill.disjoint_simulation(4));
+        expected.push_back(anthill.simulate_dijkstra_disjoint(4));
+    }
+
+    auto play = [&](int threads, const SimulationScheduler::StepObserver& observer, long long& steps, bool& same) {
+        SimulationScheduler scheduler;
+        for (const SimulationStepper& simulation : simulations) scheduler.add(simulation);
+        auto start = std::chrono::high_resolution_clock::now();
+        scheduler.run(threads, 16, observer);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        steps = 0;
+        same = true;
+        for (size_t id = 0; id < scheduler.simulations().size(); id++) {
+            const SimulationStepper& simulation = scheduler.simulations()[id];
+            steps += simulation.steps();
+            if (!scheduler.stopped(id) && simulation.result() != expected[id]) same = false;
+        }
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    };
+
+    const int value_width = 14;
+    std::cout << "\nStepping " << count << " disjoint-route simulations (caves of 162 to 290 rooms):\n";
+    std::cout << std::right
+              << std::setw(value_width) << "THREADS"
+              << std::setw(value_width) << "TIME (ms)"
+              << std::setw(value_width) << "STEPS"
+              << std::setw(value_width) << "SIMS/S"
+              << std::setw(value_width) << "SPEEDUP"
+              << std::setw(value_width) << "SAME RESULT"
+              << "\n" << std::string(6 * value_width, '=') << "\n";
+
+    // One thread, one simulation after the other, as calling simulate_* in a loop would
+    long long total_steps = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<SimulationStepper> sequential = simulations;
+    bool sequential_same = true;
+    for (size_t id = 0; id < sequential.size(); id++) {
+        while (sequential[id].advance()) {}
+        total_steps += sequential[id].steps();
+        if (sequential[id].result() != expected[id]) sequential_same = false;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double sequential_ms = std::chrono::duration<double, std::milli>(end - start).count();
+    std::cout << std::setw(value_width) << "in turn"
+              << std::setw(value_width) << std::fixed << std::setprecision(3) << sequential_ms
+              << std::setw(value_width) << total_steps
+              << std::setw(value_width) << std::setprecision(0) << count / (sequential_ms / 1000.0)
+              << std::setw(value_width) << "-"
+              << std::setw(value_width) << (sequential_same ? "yes" : "NO") << "\n";
+
+    for (int threads : thread_counts) {
+        long long steps;
+        bool same;
+        double time_ms = play(threads, nullptr, steps, same);
+        std::cout << std::setw(value_width) << threads
+                  << std::setw(value_width) << std::setprecision(3) << time_ms
+                  << std::setw(value_width) << steps
+                  << std::setw(value_width) << std::setprecision(0) << count / (time_ms / 1000.0)
+                  << std::setw(value_width - 1) << std::setprecision(2) << sequential_ms / time_ms << "x"
+                  << std::setw(value_width) << (same ? "yes" : "NO") << "\n";
+    }
+
+    long long early_steps;
+    bool same;
+    double early_ms = play(max_threads, [](size_t, const SimulationStepper& simulation) {
+        return simulation.arrived() * 2 < simulation.ants();
+    }, early_steps, same);
+    std::cout << "Stopped at half the colony: " << std::setprecision(3) << early_ms << " ms, "
+              << early_steps << " of " << total_steps << " steps played\n" << std::defaultfloat;
+}
@@ -0,0 +1,112 @@
+#include "reports.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "ants_astar.h"
+#include "ants_dijkstra.h"
+#include "room_hills.h"
+#include "trace_log.h"
+#include "trace_replay.h"
+
+void print_trace_report(const std::string& path) {
+    const int runs = 5;
+    RoomHill cave = make_cave_hill(200, 40, 5000, 11);
+
+    struct Simulation {
+        std::string name;
+        std::function<int(TraceLog*)> run;
+    };
+    std::vector<Simulation> simulations = {
+        {"simulate_astar", [&](TraceLog* trace) {
+            AnthillAStar anthill = cave.build<AnthillAStar>();
+            anthill.set_verbose(false);
+            anthill.set_trace(trace);
+            return anthill.simulate_astar();
+        }},
+        {"simulate_dijkstra", [&](TraceLog* trace) {
+            AnthillDijkstra anthill = cave.build<AnthillDijkstra>();
+            anthill.set_verbose(false);
+            anthill.set_trace(trace);
+            return anthill.simulate_dijkstra();
+        }},
+        {"disjoint (k=8)", [&](TraceLog* trace) {
+            AnthillDijkstra anthill = cave.build<AnthillDijkstra>();
+            anthill.set_verbose(false);
+            anthill.set_trace(trace);
+            return anthill.simulate_dijkstra_disjoint(8);
+        }},
+    };
+
+    const int name_width = 20;
+    const int value_width = 14;
+    std::cout << "\nTrace logging (" << cave.name << ", best of " << runs << " runs):\n";
+    std::cout << std::left << std::setw(name_width) << "SIMULATION" << std::right
+              << std::setw(value_width) << "STEPS"
+              << std::setw(value_width) << "EVENTS"
+              << std::setw(value_width) << "TRACE (KB)"
+              << std::setw(value_width) << "HEADLESS (ms)"
+              << std::setw(value_width) << "TRACED (ms)"
+              << std::setw(value_width) << "OVERHEAD"
+              << std::setw(value_width) << "SEEK (ms)"
+              << "\n" << std::string(name_width + 7 * value_width, '=') << "\n";
+
+    for (const auto& simulation : simulations) {
+        double headless_ms = 0.0, traced_ms = 0.0;
+        int steps = 0;
+        long long events = 0, stalls = 0, bytes = 0;
+        for (int run = 0; run < runs; run++) {
+            auto start = std::chrono::high_resolution_clock::now();
+            steps = simulation.run(nullptr);
+            auto end = std::chrono::high_resolution_clock::now();
+            double ms = std::chrono::duration<double, std::milli>(end - start).count();
+            headless_ms = run == 0 ? ms : std::min(headless_ms, ms);
+
+            // Timed up to the last event recorded: the writer finishes the file afterwards
+            TraceLog trace(path);
+            if (!trace.is_open()) {
+                std::cerr << "Cannot write " << path << "\n";
+                return;
+            }
+            start = std::chrono::high_resolution_clock::now();
+            simulation.run(&trace);
+            end = std::chrono::high_resolution_clock::now();
+            ms = std::chrono::duration<double, std::milli>(end - start).count();
+            traced_ms = run == 0 ? ms : std::min(traced_ms, ms);
+            trace.close();
+            events = trace.events();
+            stalls = trace.stalls();
+            bytes = trace.bytes_written();
+        }
+
+        // Rebuilt from the nearest snapshot, without running the solver again
+        TraceReplay replay;
+        std::string error;
+        auto start = std::chrono::high_resolution_clock::now();
+        bool opened = replay.open(path, error) && !replay.runs().empty();
+        if (opened) replay.occupancy(0, replay.runs()[0].steps() / 2);
+        auto end = std::chrono::high_resolution_clock::now();
+        double seek_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        std::cout << std::left << std::setw(name_width) << simulation.name << std::right
+                  << std::setw(value_width) << steps
+                  << std::setw(value_width) << events
+                  << std::setw(value_width) << bytes / 1024
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(value_width) << headless_ms
+                  << std::setw(value_width) << traced_ms
+                  << std::setw(value_width - 1) << std::setprecision(1)
+                  << 100.0 * (traced_ms - headless_ms) / headless_ms << "%"
+                  << std::setw(value_width) << std::setprecision(3) << seek_ms << "\n";
+        if (!opened) {
+            std::cout << "  (cannot replay: " << error << ")\n";
+        }
+        if (stalls > 0) {
+            std::cout << "  (ring full " << stalls << " time(s): the writer fell behind)\n";
+        }
+    }
+    std::cout << "Last trace kept in " << path << "\n" << std::defaultfloat;
+}
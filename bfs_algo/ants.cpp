@@ -1,4 +1,6 @@
 #include "ants.h"
+#include "parallel_paths.h"
+#include "path_stats.h"
 #include <iostream>
 #include <algorithm>
 #include <queue>
@@ -7,15 +9,25 @@
 #include <thread>
 #include <chrono>
 
-Anthill::Anthill(int total_rooms, int total_ants) : total_rooms(total_rooms), total_ants(total_ants) {
+Anthill::Anthill(int total_rooms, int total_ants)
+    : total_rooms(total_rooms), total_ants(total_ants), connected_rooms(total_rooms) {
     graph.resize(total_rooms);
     ants.resize(total_rooms, 0);
     room_capacity.resize(total_rooms, 0);
 }
 
-void Anthill::add_tunnels(int a, int b) {
+bool Anthill::add_tunnels(int a, int b) {
+    if (a == b || !tunnels.insert(a, b)) return false;
     graph[a].push_back(b);
     graph[b].push_back(a);
+    connected_rooms.connect(a, b);
+    return true;
+}
+
+void Anthill::add_tunnels(const std::vector<std::pair<int, int>>& tunnel_list) {
+    reserve_tunnel_lists(graph, tunnel_list);
+    tunnels.reserve(tunnels.size() + tunnel_list.size());
+    for (const auto& [a, b] : tunnel_list) add_tunnels(a, b);
 }
 
 void Anthill::set_room_capacity(int room, int c) {
@@ -26,11 +38,35 @@ bool Anthill::is_full(int ants, int c) {
     return ants >= c;
 }
 
-bool Anthill::has_tunnel(int a, int b) {
-    return std::find(graph[a].begin(), graph[a].end(), b) != graph[a].end();
+bool Anthill::has_tunnel(int a, int b) const {
+    return tunnels.contains(a, b);
+}
+
+bool Anthill::dormitory_reachable() const {
+    return total_rooms > 0 && connected_rooms.connected(0, total_rooms - 1);
+}
+
+void Anthill::set_verbose(bool v) {
+    verbose = v;
 }
 
-void Anthill::simulate_dfs() {
+void Anthill::set_trace(TraceLog* t) {
+    trace = t;
+}
+
+std::ostream& Anthill::out() {
+    return verbose ? static_cast<std::ostream&>(std::cout) : quiet;
+}
+
+int Anthill::simulate_dfs(long long* expanded) {
+    return run_simulation(all_paths_sorted(expanded));
+}
+
+std::vector<std::vector<int>> Anthill::all_paths_sorted(long long* expanded) const {
+    if (expanded) *expanded = 0;
+    // The DFS below would try every simple path out of the start before giving up
+    if (!dormitory_reachable()) return {};
+
     int end_room = total_rooms - 1;
     int start_room = 0;
 
@@ -38,6 +74,7 @@ void Anthill::simulate_dfs() {
     all_paths.reserve(1000);
     std::vector<int> path;
     std::function<void(int)> dfs = [&](int current) {
+        if (expanded) (*expanded)++;
         path.push_back(current);
         if (current == end_room) {
             all_paths.push_back(path);
@@ -52,6 +89,17 @@ void Anthill::simulate_dfs() {
     };
     dfs(start_room);
 
+    sort_paths(all_paths);
+    return all_paths;
+}
+
+SimulationStepper Anthill::dfs_simulation() const {
+    std::vector<std::vector<int>> all_paths = all_paths_sorted();
+    if (all_paths.empty()) return SimulationStepper();
+    return SimulationStepper(std::move(all_paths), room_capacity, total_ants);
+}
+
+void Anthill::sort_paths(std::vector<std::vector<int>>& all_paths) const {
     // Priorité sur le nombre de noeud, puis la capacité des noeuds
     std::sort(all_paths.begin(), all_paths.end(), [&](const std::vector<int>& a, const std::vector<int>& b) {
         int sum_a = 0, sum_b = 0;
@@ -71,99 +119,213 @@ void Anthill::simulate_dfs() {
         //if (sum_a != sum_b) return sum_a > sum_b;          
         //return a.size() < b.size();                        
     //});
+}
+
+std::vector<std::vector<int>> Anthill::enumerate_paths(int threads) const {
+    if (!dormitory_reachable()) return {};
+    std::vector<std::vector<int>> all_paths = enumerate_paths_parallel(graph, 0, total_rooms - 1, threads);
+    sort_paths(all_paths);
+    return all_paths;
+}
+
+int Anthill::find_shortest_path(BfsWorkspace& workspace, std::vector<int>& path, long long* expanded) const {
+    if (!dormitory_reachable()) {
+        path.clear();
+        if (expanded) *expanded = 0;
+        return -1;
+    }
+    return best_first_search(AdjacencyList(graph), 0, total_rooms - 1, workspace, &path, expanded);
+}
+
+BfsTraversal Anthill::room_distances(int threads) const {
+    return direction_optimizing_bfs(graph, 0, threads);
+}
+
+PathStatistics Anthill::analyze_paths() const {
+    return analyze_shortest_paths(graph, room_capacity, 0, total_rooms - 1);
+}
+
+void Anthill::print_path_analysis() const {
+    PathStatistics stats = analyze_paths();
 
-    // Print simulation header
     std::cout << "\n" << std::string(60, '=') << "\n";
-    std::cout << "  🐜 ANT SIMULATION - STARTING" << "\n";
+    std::cout << "  📊 SHORTEST ROUTE ANALYSIS" << "\n";
     std::cout << "  Rooms: " << total_rooms << " | Ants: " << total_ants << "\n";
     std::cout << std::string(60, '=') << "\n\n";
 
-    if (all_paths.empty()) {
+    if (stats.shortest_steps < 0) {
         std::cout << "❌ No paths found from start to dormitory!\n";
         return;
     }
 
-    // Print all found paths with better formatting
-    std::cout << "🔍 Found " << all_paths.size() << " possible path(s) from Start (Room 0) "
-              << "to Dormitory (Room " << end_room << "):\n\n";
-    for (size_t i = 0; i < all_paths.size(); ++i) {
-        std::cout << "  🛣️  Path #" << i + 1 << " (" << all_paths[i].size() - 1 
-                  << " steps): ";
-        for (size_t j = 0; j < all_paths[i].size(); ++j) {
-            std::cout << all_paths[i][j];
-            if (j < all_paths[i].size() - 1) {
+    std::string at_least = stats.saturated ? "at least " : "";
+    std::cout << "  • Shortest route length: " << stats.shortest_steps << " steps\n";
+    std::cout << "  • Number of shortest routes: " << at_least << stats.shortest_paths << "\n";
+    std::cout << "  • Total capacity on shortest routes: " << stats.min_total_capacity
+              << " to " << stats.max_total_capacity << "\n\n";
+
+    std::cout << "  Shortest routes by bottleneck capacity:\n";
+    for (const auto& [bottleneck, count] : stats.bottleneck_distribution) {
+        std::cout << "    capacity " << bottleneck << ": " << at_least << count << " route(s)\n";
+    }
+    std::cout << "\n";
+}
+
+std::vector<ParetoRoute> Anthill::pareto_paths() const {
+    if (!dormitory_reachable()) return {};
+    return pareto_routes(graph, room_capacity, 0, total_rooms - 1);
+}
+
+void Anthill::print_pareto_paths() const {
+    std::vector<ParetoRoute> front = pareto_paths();
+
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "  ⚖️  ROUTE TRADE-OFFS (PARETO FRONT)" << "\n";
+    std::cout << "  Rooms: " << total_rooms << " | Ants: " << total_ants << "\n";
+    std::cout << std::string(60, '=') << "\n\n";
+
+    if (front.empty()) {
+        std::cout << "❌ No paths found from start to dormitory!\n";
+        return;
+    }
+
+    for (const ParetoRoute& route : front) {
+        std::cout << "  🛣️  " << route.steps << " steps, smallest room " << route.min_capacity
+                  << ", total capacity " << route.total_capacity << ": ";
+        for (size_t i = 0; i < route.path.size(); ++i) {
+            std::cout << route.path[i];
+            if (i < route.path.size() - 1) {
                 std::cout << " → ";
             }
         }
         std::cout << "\n";
     }
+    std::cout << "\n";
+}
 
-    std::vector<int> ants_per_room(total_rooms, 0);
-    ants_per_room[0] = total_ants;
-    int steps = 0;
+PathGenerator Anthill::paths() const {
+    return PathGenerator(graph, room_capacity, 0, total_rooms - 1);
+}
 
-    std::cout << "\n" << std::string(60, '=') << "\n";
-    std::cout << "  🚀 SIMULATION STARTING - MOVING ANTS TO DORMITORY" << "\n";
-    std::cout << std::string(60, '=') << "\n\n";
+std::vector<std::vector<int>> Anthill::top_paths(int k) const {
+    // Same order as simulate_dfs, but only the k best paths are ever built
+    std::vector<std::vector<int>> top_paths;
+    if (!dormitory_reachable()) return top_paths;
+    PathGenerator generator = paths();
+    std::vector<int> path;
+    while (static_cast<int>(top_paths.size()) < k && generator.next(path)) {
+        top_paths.push_back(path);
+    }
+    return top_paths;
+}
+
+int Anthill::simulate_top_paths(int k) {
+    return run_simulation(top_paths(k));
+}
+
+SimulationStepper Anthill::top_paths_simulation(int k) const {
+    std::vector<std::vector<int>> best = top_paths(k);
+    if (best.empty()) return SimulationStepper();
+    return SimulationStepper(std::move(best), room_capacity, total_ants);
+}
+
+int Anthill::run_simulation(const std::vector<std::vector<int>>& all_paths) {
+    int end_room = total_rooms - 1;
 
-    while (ants_per_room[end_room] < total_ants) {
-        std::cout << "\n⏱️  STEP " << steps << "\n";
-        std::cout << std::string(30, '-') << "\n";
-        
-        std::vector<int> next_ants = ants_per_room;
-        bool movement_occurred = false;
-
-        // For each path, try to move ants along it
-        for (const auto& path : all_paths) {
-            for (int i = path.size() - 2; i >= 0; --i) {
-                int from = path[i];
-                int to = path[i + 1];
-
-                int available = next_ants[from];
-                int capacity_left = room_capacity[to] - next_ants[to];
-                int can_send = std::min(available, capacity_left);
-
-                if (can_send > 0) {
-                    movement_occurred = true;
-                    next_ants[from] -= can_send;
-                    next_ants[to] += can_send;
-                    std::cout << "  🐜 " << can_send << " ant(s) moved from Room " 
-                              << from << " to Room " << to << "\n";
+    // Print simulation header
+    if (verbose) {
+        out() << "\n" << std::string(60, '=') << "\n";
+        out() << "  🐜 ANT SIMULATION - STARTING" << "\n";
+        out() << "  Rooms: " << total_rooms << " | Ants: " << total_ants << "\n";
+        out() << std::string(60, '=') << "\n\n";
+    }
+
+    if (all_paths.empty()) {
+        out() << "❌ No paths found from start to dormitory!\n";
+        return -1;
+    }
+
+    // Print all found paths with better formatting
+    if (verbose) {
+        out() << "🔍 Found " << all_paths.size() << " possible path(s) from Start (Room 0) "
+              << "to Dormitory (Room " << end_room << "):\n\n";
+        for (size_t i = 0; i < all_paths.size(); ++i) {
+            out() << "  🛣️  Path #" << i + 1 << " (" << all_paths[i].size() - 1 
+                  << " steps): ";
+            for (size_t j = 0; j < all_paths[i].size(); ++j) {
+                out() << all_paths[i][j];
+                if (j < all_paths[i].size() - 1) {
+                    out() << " → ";
                 }
             }
+            out() << "\n";
+        }
+    }
+
+    SimulationStepper simulation(all_paths, room_capacity, total_ants);
+    const std::vector<int>& ants_per_room = simulation.occupancy();
+
+    if (verbose) {
+        out() << "\n" << std::string(60, '=') << "\n";
+        out() << "  🚀 SIMULATION STARTING - MOVING ANTS TO DORMITORY" << "\n";
+        out() << std::string(60, '=') << "\n\n";
+    }
+
+    if (trace) trace->start_run(room_capacity, total_ants);
+
+    while (!simulation.done()) {
+        int steps = simulation.steps();
+        if (trace) trace->record(TraceEvent::step(steps));
+        if (verbose) {
+            out() << "\n⏱️  STEP " << steps << "\n";
+            out() << std::string(30, '-') << "\n";
         }
 
-        // Update ant counts
-        ants_per_room = next_ants;
+        // Each path in turn, from its last tunnel back to the start
+        simulation.advance();
+        for (const AntMove& move : simulation.moves()) {
+            if (trace) trace->record(TraceEvent::move(move.ants, move.from, move.to));
+            if (!verbose) continue;
+            out() << "  🐜 " << move.ants << " ant(s) moved from Room " 
+                  << move.from << " to Room " << move.to << "\n";
+        }
 
         // Print current room status
-        std::cout << "\n  ROOM STATUS (" << ants_per_room[end_room] << "/" << total_ants 
+        if (verbose) {
+            out() << "\n  ROOM STATUS (" << ants_per_room[end_room] << "/" << total_ants
                   << " ants in dormitory):\n";
-        for (int i = 0; i < total_rooms; ++i) {
-            std::string room_type = (i == 0) ? "START" : 
-                                   (i == end_room) ? "DORMITORY" : "ROOM";
-            std::cout << "  • " << room_type << " " << i << ": " 
+            for (int i = 0; i < total_rooms; ++i) {
+                std::string room_type = (i == 0) ? "START" : 
+                                       (i == end_room) ? "DORMITORY" : "ROOM";
+                out() << "  • " << room_type << " " << i << ": " 
                       << ants_per_room[i] << "/" << room_capacity[i] << " ants";
-            if (i == end_room && ants_per_room[i] > 0) {
-                std::cout << " 🏠";
+                if (i == end_room && ants_per_room[i] > 0) {
+                    out() << " 🏠";
+                }
+                out() << "\n";
             }
-            std::cout << "\n";
         }
 
-        if (!movement_occurred && ants_per_room[end_room] < total_ants) {
-            std::cout << "\n⚠️  No movement possible - ants are stuck! Check room capacities.\n";
+        if (simulation.stuck()) {
+            if (trace) trace->record(TraceEvent::stuck(steps));
+            out() << "\n⚠️  No movement possible - ants are stuck! Check room capacities.\n";
             break;
         }
 
-        steps++;
-        
         // Small delay for better visualization (500ms)
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        if (verbose) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        }
     }
 
-    std::cout << "\n" << std::string(60, '=') << "\n";
-    std::cout << "  🎉 SIMULATION COMPLETE! 🎉" << "\n";
-    std::cout << "  All " << total_ants << " ants reached the dormitory" << "\n";
-    std::cout << "  Total steps: " << steps << "\n";
-    std::cout << std::string(60, '=') << "\n\n";
+    if (verbose) {
+        out() << "\n" << std::string(60, '=') << "\n";
+        out() << "  🎉 SIMULATION COMPLETE! 🎉" << "\n";
+        out() << "  All " << total_ants << " ants reached the dormitory" << "\n";
+        out() << "  Total steps: " << simulation.steps() << "\n";
+        out() << std::string(60, '=') << "\n\n";
+    }
+    int result = simulation.result();
+    if (trace) trace->record(TraceEvent::finish(result));
+    return result;
 } 
\ No newline at end of file
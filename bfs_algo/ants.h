@@ -1,7 +1,18 @@
 #ifndef ANTS_H
 #define ANTS_H
 
+#include <ostream>
 #include <vector>
+#include "path_generator.h"
+#include "path_stats.h"
+#include "pareto_routes.h"
+#include "parallel_bfs.h"
+#include "null_stream.h"
+#include "room_connectivity.h"
+#include "search_core.h"
+#include "simulation_stepper.h"
+#include "tunnel_set.h"
+#include "trace_log.h"
 
 class Anthill {
     int total_rooms;
@@ -9,14 +20,87 @@ class Anthill {
     std::vector<std::vector<int>> graph;
     std::vector<int> ants;
     std::vector<int> room_capacity;
+    TunnelSet tunnels;  // Every tunnel of graph once, for has_tunnel and duplicates
+    RoomConnectivity connected_rooms;  // Grown by add_tunnels
+    bool verbose = true;
+    TraceLog* trace = nullptr;
+
+    NullStream quiet;  // Per solver, so quiet runs on several threads share no stream
+
+    // std::cout, or a stream that discards everything when verbose is off
+    std::ostream& out();
+
+    // Orders paths by number of rooms, then by highest total capacity
+    void sort_paths(std::vector<std::vector<int>>& all_paths) const;
+
+    // Every simple start -> dormitory path by DFS, in sort_paths order. expanded,
+    // if given, receives the number of rooms the DFS entered.
+    std::vector<std::vector<int>> all_paths_sorted(long long* expanded = nullptr) const;
+
+    // The k first paths of that order, from the lazy generator
+    std::vector<std::vector<int>> top_paths(int k) const;
+
+    // Moves the ants along the given paths step by step, printing each move
+    // Returns the number of steps, or -1 if the ants never all reached the dormitory
+    int run_simulation(const std::vector<std::vector<int>>& all_paths);
 
 public:
     Anthill(int total_rooms, int total_ants);
-    void add_tunnels(int a, int b);
+    // Returns false, adding nothing, for a tunnel already there or one from a room to itself
+    bool add_tunnels(int a, int b);
+    // Bulk build: reserves every adjacency list once, then adds the tunnels in order
+    void add_tunnels(const std::vector<std::pair<int, int>>& tunnel_list);
     void set_room_capacity(int room, int capacity);
     bool is_full(int ants, int capacity);
-    bool has_tunnel(int a, int b);
-    void simulate_dfs();
+    bool has_tunnel(int a, int b) const;
+
+    // Whether some route joins the start and the dormitory, from the tunnels added
+    // so far and without a search. The path finders below return nothing at once if not.
+    bool dormitory_reachable() const;
+    const RoomConnectivity& connectivity() const { return connected_rooms; }
+
+    // Quiet mode: the simulate_* functions neither print nor pause between steps
+    void set_verbose(bool verbose);
+
+    // Records every simulation step and move into trace, or stops recording if null.
+    // Independent of verbose: a quiet run with a trace formats nothing until the trace is read.
+    void set_trace(TraceLog* trace);
+
+    // Each simulate_* function returns the number of steps taken, or -1 on failure.
+    // expanded, if given, receives the number of rooms its path search entered.
+    int simulate_dfs(long long* expanded = nullptr);
+
+    // Every simple start -> dormitory path, enumerated on `threads` threads and
+    // returned in simulate_dfs order
+    std::vector<std::vector<int>> enumerate_paths(int threads) const;
+
+    // Route from the start to the dormitory with the fewest tunnels, by BFS. Returns its
+    // number of tunnels, or -1; expanded, if given, receives the number of rooms expanded.
+    int find_shortest_path(BfsWorkspace& workspace, std::vector<int>& path, long long* expanded = nullptr) const;
+
+    // Tunnels from the start to every room, by direction-optimizing BFS on `threads` threads
+    BfsTraversal room_distances(int threads) const;
+
+    // Shortest route counts and bottleneck distribution, without enumerating paths
+    PathStatistics analyze_paths() const;
+    void print_path_analysis() const;
+
+    // Routes not beaten on all of (steps, smallest room, total capacity): every
+    // trade-off between the two sort_paths orders, from one search
+    std::vector<ParetoRoute> pareto_paths() const;
+    void print_pareto_paths() const;
+
+    // Lazy generator over start -> dormitory paths, in simulate_dfs order
+    // (fewest rooms, then highest capacity). Valid while this anthill is alive.
+    PathGenerator paths() const;
+
+    // Like simulate_dfs, but only uses the k best paths and never enumerates the rest
+    int simulate_top_paths(int k);
+
+    // simulate_dfs and simulate_top_paths as resumable simulations, played one
+    // advance() at a time by the caller; nothing is printed or traced
+    SimulationStepper dfs_simulation() const;
+    SimulationStepper top_paths_simulation(int k) const;
 };
 
 #endif
\ No newline at end of file
@@ -183,6 +183,8 @@ int main() {
     //std::cout << " Simulation de big hill :\n";
     //Big_hill.simulate_bfs();
     std::cout << "Simulation de King hill :\n";
+    King_hill.print_path_analysis();
+    King_hill.print_pareto_paths();
     King_hill.simulate_dfs();
 
     return 0;
@@ -0,0 +1,140 @@
+#include "parallel_bfs.h"
+#include "worker_team.h"
+#include <cstdint>
+#include <memory>
+
+namespace {
+    // Switching thresholds from the paper
+    const long long ALPHA = 14;
+    const long long BETA = 24;
+
+    const size_t WORDS_PER_CHUNK = 64;  // Bitmap words, so 4096 rooms, per bottom-up task
+
+    bool test_bit(const std::vector<std::uint64_t>& bitmap, int room) {
+        return (bitmap[room / 64] >> (room % 64)) & 1;
+    }
+}
+
+BfsTraversal direction_optimizing_bfs(const std::vector<std::vector<int>>& graph, int start_room, int threads) {
+    const int rooms = static_cast<int>(graph.size());
+    const size_t words = (static_cast<size_t>(rooms) + 63) / 64;
+    WorkerTeam team(std::max(1, threads));
+
+    std::unique_ptr<std::atomic<int>[]> distance(new std::atomic<int>[rooms]);
+    long long unexplored_edges = 0;  // Tunnels leaving rooms not reached yet
+    for (int room = 0; room < rooms; ++room) {
+        distance[room].store(-1, std::memory_order_relaxed);
+        unexplored_edges += static_cast<long long>(graph[room].size());
+    }
+
+    // Per-thread results of one level, merged after it
+    struct LevelCounts {
+        std::vector<int> reached;   // Top-down only: rooms claimed by this thread
+        long long rooms = 0;
+        long long edges = 0;        // Tunnels leaving the rooms claimed
+    };
+    std::vector<LevelCounts> counts(team.size());
+
+    BfsTraversal result;
+    std::vector<int> frontier = {start_room};
+    std::vector<std::uint64_t> frontier_bits(words, 0);
+    std::vector<std::uint64_t> next_bits(words, 0);
+    long long frontier_rooms = 1;
+    long long previous_rooms = 0;
+    long long frontier_edges = static_cast<long long>(graph[start_room].size());
+    bool bottom_up = false;
+
+    distance[start_room].store(0, std::memory_order_relaxed);
+    unexplored_edges -= frontier_edges;
+    long long reached_edges = frontier_edges;
+
+    for (int level = 0; frontier_rooms > 0; ++level) {
+        // Pick the direction for this level. Only a growing frontier goes bottom-up and
+        // only a shrinking one comes back, or a long thin hill would flip at every level.
+        bool growing = frontier_rooms > previous_rooms;
+        if (!bottom_up && growing && frontier_edges > unexplored_edges / ALPHA) {
+            bottom_up = true;
+            std::fill(frontier_bits.begin(), frontier_bits.end(), 0);
+            for (int room : frontier) frontier_bits[room / 64] |= std::uint64_t(1) << (room % 64);
+        } else if (bottom_up && !growing && frontier_rooms < rooms / BETA) {
+            bottom_up = false;
+            frontier.clear();
+            for (int room = 0; room < rooms; ++room) {
+                if (test_bit(frontier_bits, room)) frontier.push_back(room);
+            }
+        }
+
+        if (bottom_up) {
+            result.bottom_up_levels++;
+            ChunkCounter chunks(words, WORDS_PER_CHUNK);
+            team.run([&](int thread) {
+                LevelCounts& local = counts[thread];
+                size_t begin, end;
+                while (chunks.take(begin, end)) {
+                    for (size_t word = begin; word < end; ++word) {
+                        std::uint64_t found = 0;
+                        int last_room = std::min(rooms, static_cast<int>(word * 64 + 64));
+                        for (int room = static_cast<int>(word * 64); room < last_room; ++room) {
+                            if (distance[room].load(std::memory_order_relaxed) >= 0) continue;
+                            for (int neighbor : graph[room]) {
+                                if (test_bit(frontier_bits, neighbor)) {
+                                    distance[room].store(level + 1, std::memory_order_relaxed);
+                                    found |= std::uint64_t(1) << (room % 64);
+                                    local.rooms++;
+                                    local.edges += static_cast<long long>(graph[room].size());
+                                    break;
+                                }
+                            }
+                        }
+                        next_bits[word] = found;  // This word belongs to this thread alone
+                    }
+                }
+            });
+            frontier_bits.swap(next_bits);
+        } else {
+            result.top_down_levels++;
+            ChunkCounter chunks(frontier.size());
+            team.run([&](int thread) {
+                LevelCounts& local = counts[thread];
+                size_t begin, end;
+                while (chunks.take(begin, end)) {
+                    for (size_t i = begin; i < end; ++i) {
+                        for (int neighbor : graph[frontier[i]]) {
+                            int unvisited = -1;
+                            if (distance[neighbor].load(std::memory_order_relaxed) < 0 &&
+                                distance[neighbor].compare_exchange_strong(unvisited, level + 1,
+                                                                           std::memory_order_relaxed)) {
+                                local.reached.push_back(neighbor);
+                                local.rooms++;
+                                local.edges += static_cast<long long>(graph[neighbor].size());
+                            }
+                        }
+                    }
+                }
+            });
+            frontier.clear();
+            for (LevelCounts& local : counts) {
+                frontier.insert(frontier.end(), local.reached.begin(), local.reached.end());
+                local.reached.clear();
+            }
+        }
+
+        previous_rooms = frontier_rooms;
+        frontier_rooms = 0;
+        frontier_edges = 0;
+        for (LevelCounts& local : counts) {
+            frontier_rooms += local.rooms;
+            frontier_edges += local.edges;
+            local.rooms = local.edges = 0;
+        }
+        unexplored_edges -= frontier_edges;
+        reached_edges += frontier_edges;
+    }
+
+    result.distance.resize(rooms);
+    for (int room = 0; room < rooms; ++room) {
+        result.distance[room] = distance[room].load(std::memory_order_relaxed);
+    }
+    result.traversed_edges = reached_edges / 2;  // Every tunnel is listed at both ends
+    return result;
+}
@@ -0,0 +1,27 @@
+#ifndef PARALLEL_BFS_H
+#define PARALLEL_BFS_H
+
+#include <vector>
+
+// Result of a full breadth-first traversal from one room
+struct BfsTraversal {
+    std::vector<int> distance;        // Tunnels from the start, -1 if unreachable
+    long long traversed_edges = 0;    // Tunnels inside the reached part of the hill (for TEPS)
+    int top_down_levels = 0;
+    int bottom_up_levels = 0;
+};
+
+// Direction-optimizing BFS (Beamer, Asanović & Patterson) on `threads` threads.
+//
+// Small frontiers are expanded top-down: every frontier room claims its unvisited
+// neighbours with an atomic compare-and-swap. Once a growing frontier has more
+// tunnels than the unvisited rooms / ALPHA, it switches to bottom-up: every
+// unvisited room looks for a parent in a bitmap of the frontier and stops at the
+// first one. Each thread owns whole 64-room words of the next bitmap, so bottom-up
+// levels need no atomic read-modify-write at all. It switches back to top-down when
+// a shrinking frontier falls under rooms / BETA.
+//
+// Distances equal those of a plain sequential BFS.
+BfsTraversal direction_optimizing_bfs(const std::vector<std::vector<int>>& graph, int start_room, int threads);
+
+#endif
@@ -0,0 +1,170 @@
+#include "parallel_paths.h"
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace {
+    // Prefix tasks per thread to aim for when splitting the search tree
+    const int TASKS_PER_THREAD = 8;
+    const int MAX_SPLIT_DEPTH = 6;
+
+    struct WorkerQueue {
+        std::mutex lock;
+        std::deque<std::vector<int>> tasks;
+    };
+
+    // Flat per-thread path storage: rooms of every path back to back
+    struct PathBuffer {
+        std::vector<int> rooms;
+        std::vector<size_t> ends;
+
+        void add(const std::vector<int>& path) {
+            rooms.insert(rooms.end(), path.begin(), path.end());
+            ends.push_back(rooms.size());
+        }
+    };
+
+    bool contains(const std::vector<int>& path, int room) {
+        return std::find(path.begin(), path.end(), room) != path.end();
+    }
+
+    // Depth-first search below `prefix`, iterative to keep deep hills off the call stack
+    void enumerate_below(const std::vector<std::vector<int>>& graph, int end_room,
+                         const std::vector<int>& prefix, std::vector<char>& on_path,
+                         std::vector<int>& path, std::vector<size_t>& next_edge, PathBuffer& out) {
+        path = prefix;
+        for (int room : path) on_path[room] = 1;
+
+        if (path.back() == end_room) {
+            out.add(path);
+        } else {
+            next_edge.assign(1, 0);
+            while (!next_edge.empty()) {
+                int room = path.back();
+                size_t& edge = next_edge.back();
+
+                if (edge == graph[room].size()) {
+                    next_edge.pop_back();
+                    if (path.size() > prefix.size()) {
+                        on_path[room] = 0;
+                        path.pop_back();
+                    }
+                    continue;
+                }
+
+                int neighbor = graph[room][edge++];
+                if (on_path[neighbor]) continue;
+
+                if (neighbor == end_room) {
+                    path.push_back(neighbor);
+                    out.add(path);
+                    path.pop_back();
+                } else {
+                    on_path[neighbor] = 1;
+                    path.push_back(neighbor);
+                    next_edge.push_back(0);
+                }
+            }
+        }
+
+        for (int room : path) on_path[room] = 0;
+    }
+
+    // Breadth-first expansion of the search tree until there are enough prefixes.
+    // Prefixes that already reach end_room are kept as-is (they are complete paths).
+    std::vector<std::vector<int>> split_tasks(const std::vector<std::vector<int>>& graph,
+                                              int start_room, int end_room, int wanted) {
+        std::vector<std::vector<int>> tasks = {{start_room}};
+
+        for (int depth = 0; depth < MAX_SPLIT_DEPTH && static_cast<int>(tasks.size()) < wanted; ++depth) {
+            std::vector<std::vector<int>> next;
+            bool expanded = false;
+            for (const auto& prefix : tasks) {
+                if (prefix.back() == end_room) {
+                    next.push_back(prefix);
+                    continue;
+                }
+                for (int neighbor : graph[prefix.back()]) {
+                    if (!contains(prefix, neighbor)) {
+                        std::vector<int> child = prefix;
+                        child.push_back(neighbor);
+                        next.push_back(std::move(child));
+                        expanded = true;
+                    }
+                }
+            }
+            tasks = std::move(next);
+            if (!expanded) break;
+        }
+        return tasks;
+    }
+}
+
+std::vector<std::vector<int>> enumerate_paths_parallel(const std::vector<std::vector<int>>& graph,
+                                                       int start_room, int end_room, int threads) {
+    threads = std::max(1, threads);
+
+    std::vector<std::vector<int>> tasks = split_tasks(graph, start_room, end_room, threads * TASKS_PER_THREAD);
+
+    std::vector<WorkerQueue> queues(threads);
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        queues[i % threads].tasks.push_back(std::move(tasks[i]));
+    }
+
+    std::vector<PathBuffer> buffers(threads);
+
+    auto worker = [&](int id) {
+        std::vector<char> on_path(graph.size(), 0);
+        std::vector<int> path;
+        std::vector<size_t> next_edge;
+        std::vector<int> task;
+
+        // Every task exists before the workers start, so once all deques are
+        // empty there is nothing left to steal and the worker can stop.
+        while (true) {
+            bool found = false;
+            for (int k = 0; k < threads && !found; ++k) {
+                WorkerQueue& queue = queues[(id + k) % threads];
+                std::lock_guard<std::mutex> guard(queue.lock);
+                if (queue.tasks.empty()) continue;
+
+                if (k == 0) {
+                    task = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                } else {
+                    task = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                }
+                found = true;
+            }
+            if (!found) break;
+
+            enumerate_below(graph, end_room, task, on_path, path, next_edge, buffers[id]);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int id = 1; id < threads; ++id) {
+        pool.emplace_back(worker, id);
+    }
+    worker(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    // Merge the per-thread buffers
+    size_t total = 0;
+    for (const auto& buffer : buffers) total += buffer.ends.size();
+
+    std::vector<std::vector<int>> paths;
+    paths.reserve(total);
+    for (const auto& buffer : buffers) {
+        size_t begin = 0;
+        for (size_t end : buffer.ends) {
+            paths.emplace_back(buffer.rooms.begin() + begin, buffer.rooms.begin() + end);
+            begin = end;
+        }
+    }
+    return paths;
+}
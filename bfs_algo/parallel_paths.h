@@ -0,0 +1,18 @@
+#ifndef PARALLEL_PATHS_H
+#define PARALLEL_PATHS_H
+
+#include <vector>
+
+// Enumerates every simple path from start_room to end_room on `threads` threads.
+//
+// The search tree is cut at a shallow depth into prefix tasks (deep enough to give
+// every thread several tasks), which are dealt round-robin into per-thread deques.
+// A thread works from the back of its own deque and steals from the front of the
+// others when it runs dry. Each thread appends finished paths to its own buffer;
+// the buffers are concatenated after the join, so no lock is taken per path.
+//
+// Paths are returned in no particular order.
+std::vector<std::vector<int>> enumerate_paths_parallel(const std::vector<std::vector<int>>& graph,
+                                                       int start_room, int end_room, int threads);
+
+#endif
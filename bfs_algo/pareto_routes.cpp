@@ -0,0 +1,125 @@
+#include "pareto_routes.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+    struct Label {
+        int room;
+        int parent;  // Index of the label this one extends, -1 at the start
+        int steps;
+        int min_capacity;
+        long long total_capacity;
+        bool dead;   // Dominated after it was queued
+    };
+
+    // Rooms visited by each label, one bit per room, stored back to back
+    class VisitedSets {
+        size_t words;
+        std::vector<std::uint64_t> bits;
+
+        const std::uint64_t* get(int label) const { return &bits[label * words]; }
+
+    public:
+        explicit VisitedSets(int rooms) : words((rooms + 63) / 64) {}
+
+        // Appends the set of `parent` (or an empty set) plus `room`
+        void push_back(int parent, int room) {
+            size_t offset = bits.size();
+            bits.resize(offset + words, 0);
+            if (parent >= 0) std::copy_n(&bits[parent * words], words, &bits[offset]);
+            bits[offset + room / 64] |= std::uint64_t(1) << (room % 64);
+        }
+
+        void pop_back() {
+            bits.resize(bits.size() - words);
+        }
+
+        bool contains(int label, int room) const {
+            return (get(label)[room / 64] >> (room % 64)) & 1;
+        }
+
+        bool subset(int a, int b) const {
+            const std::uint64_t* set_a = get(a);
+            const std::uint64_t* set_b = get(b);
+            for (size_t w = 0; w < words; ++w) {
+                if (set_a[w] & ~set_b[w]) return false;
+            }
+            return true;
+        }
+    };
+
+    bool at_least_as_good(const Label& a, const Label& b) {
+        return a.steps <= b.steps && a.min_capacity >= b.min_capacity && a.total_capacity >= b.total_capacity;
+    }
+}
+
+std::vector<ParetoRoute> pareto_routes(const std::vector<std::vector<int>>& graph,
+                                       const std::vector<int>& room_capacity,
+                                       int start_room, int end_room) {
+    const int rooms = static_cast<int>(graph.size());
+    std::vector<Label> labels;
+    VisitedSets visited(rooms);
+    std::vector<std::vector<int>> labels_at(rooms);  // Live labels per room
+
+    // Keeps the label unless another one at its room dominates it, and retires the
+    // labels it dominates. Nothing leaves the dormitory, so there the visited rooms
+    // do not matter and plain dominance applies.
+    auto add_label = [&](const Label& label) {
+        int index = static_cast<int>(labels.size());
+        labels.push_back(label);
+        visited.push_back(label.parent, label.room);
+        bool terminal = label.room == end_room;
+
+        std::vector<int>& here = labels_at[label.room];
+        for (int other : here) {
+            if (at_least_as_good(labels[other], label) && (terminal || visited.subset(other, index))) {
+                labels.pop_back();
+                visited.pop_back();
+                return;
+            }
+        }
+        here.erase(std::remove_if(here.begin(), here.end(), [&](int other) {
+            bool dominated = at_least_as_good(label, labels[other]) && (terminal || visited.subset(index, other));
+            if (dominated) labels[other].dead = true;
+            return dominated;
+        }), here.end());
+        here.push_back(index);
+    };
+
+    add_label({start_room, -1, 0, room_capacity[start_room], room_capacity[start_room], false});
+
+    // Labels are appended in non-decreasing steps, so scanning them in order is a
+    // BFS by steps: a label is only dominated by labels created before it is expanded
+    for (size_t next = 0; next < labels.size(); ++next) {
+        if (labels[next].dead || labels[next].room == end_room) continue;
+        const int index = static_cast<int>(next);
+        const Label current = labels[next];
+
+        for (int neighbor : graph[current.room]) {
+            if (visited.contains(index, neighbor)) continue;
+            add_label({neighbor, index, current.steps + 1,
+                       std::min(current.min_capacity, room_capacity[neighbor]),
+                       current.total_capacity + room_capacity[neighbor], false});
+        }
+    }
+
+    std::vector<ParetoRoute> front;
+    for (int index : labels_at[end_room]) {
+        ParetoRoute route;
+        route.steps = labels[index].steps;
+        route.min_capacity = labels[index].min_capacity;
+        route.total_capacity = labels[index].total_capacity;
+        for (int label = index; label >= 0; label = labels[label].parent) {
+            route.path.push_back(labels[label].room);
+        }
+        std::reverse(route.path.begin(), route.path.end());
+        front.push_back(std::move(route));
+    }
+
+    std::sort(front.begin(), front.end(), [](const ParetoRoute& a, const ParetoRoute& b) {
+        if (a.steps != b.steps) return a.steps < b.steps;
+        if (a.min_capacity != b.min_capacity) return a.min_capacity > b.min_capacity;
+        return a.total_capacity > b.total_capacity;
+    });
+    return front;
+}
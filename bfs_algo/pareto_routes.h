@@ -0,0 +1,28 @@
+#ifndef PARETO_ROUTES_H
+#define PARETO_ROUTES_H
+
+#include <vector>
+
+// One route of the Pareto front and its three objectives
+struct ParetoRoute {
+    std::vector<int> path;
+    int steps = 0;                  // Tunnels taken (fewer is better)
+    int min_capacity = 0;           // Smallest room on the route (larger is better)
+    long long total_capacity = 0;   // Sum of the room capacities, as sort_paths counts it (larger is better)
+};
+
+// Every simple start -> dormitory route that no other route beats on all of
+// (steps, min_capacity, total_capacity), one route per objective vector, by
+// increasing steps then decreasing min_capacity and total_capacity.
+//
+// Label-setting search: labels (room, objectives, rooms visited) are expanded by
+// increasing steps. A label is dropped when another label at the same room is at
+// least as good on every objective and has visited a subset of its rooms, so every
+// simple extension of the dropped label is also open to the kept one and the front
+// stays exact. Worst case is still exponential, but only non-dominated partial
+// routes are ever extended, instead of every simple path as in simulate_dfs.
+std::vector<ParetoRoute> pareto_routes(const std::vector<std::vector<int>>& graph,
+                                       const std::vector<int>& room_capacity,
+                                       int start_room, int end_room);
+
+#endif
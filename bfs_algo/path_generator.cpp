@@ -0,0 +1,113 @@
+#include "path_generator.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <tuple>
+
+PathGenerator::PathGenerator(const std::vector<std::vector<int>>& graph, const std::vector<int>& room_capacity,
+                             int start_room, int end_room)
+    : graph(graph), room_capacity(room_capacity), start_room(start_room), end_room(end_room) {
+    blocked_room.resize(graph.size(), 0);
+}
+
+PathGenerator::Candidate PathGenerator::make_candidate(std::vector<int> path) const {
+    long long capacity = 0;
+    for (int room : path) capacity += room_capacity[room];
+    return Candidate{static_cast<int>(path.size()) - 1, capacity, std::move(path)};
+}
+
+// Best route from spur to end_room avoiding blocked rooms and tunnels,
+// by fewest rooms then highest capacity. The route starts with spur.
+bool PathGenerator::spur_path(int spur, std::vector<int>& path) {
+    const int rooms = static_cast<int>(graph.size());
+    const int unreached = std::numeric_limits<int>::max();
+
+    // (length, -capacity, room): smallest tuple is the best label
+    using Label = std::tuple<int, long long, int>;
+    std::priority_queue<Label, std::vector<Label>, std::greater<>> pq;
+    std::vector<int> length(rooms, unreached);
+    std::vector<long long> capacity(rooms, 0);
+    std::vector<int> previous(rooms, -1);
+    std::vector<char> done(rooms, 0);
+
+    length[spur] = 0;
+    pq.push({0, 0, spur});
+
+    while (!pq.empty()) {
+        auto [len, neg_cap, room] = pq.top();
+        pq.pop();
+        if (done[room]) continue;
+        done[room] = 1;
+
+        if (room == end_room) {
+            path.clear();
+            for (int r = end_room; r != -1; r = previous[r]) path.push_back(r);
+            std::reverse(path.begin(), path.end());
+            return true;
+        }
+
+        for (int neighbor : graph[room]) {
+            if (blocked_room[neighbor] || done[neighbor]) continue;
+            if (std::find(blocked_tunnels.begin(), blocked_tunnels.end(),
+                          std::make_pair(room, neighbor)) != blocked_tunnels.end()) {
+                continue;
+            }
+
+            int new_length = len + 1;
+            long long new_capacity = -neg_cap + room_capacity[neighbor];
+            if (new_length < length[neighbor] ||
+                (new_length == length[neighbor] && new_capacity > capacity[neighbor])) {
+                length[neighbor] = new_length;
+                capacity[neighbor] = new_capacity;
+                previous[neighbor] = room;
+                pq.push({new_length, -new_capacity, neighbor});
+            }
+        }
+    }
+    return false;
+}
+
+// Yen's step: every path deviating from `last` at some spur room, with the
+// prefix up to the spur shared and the next tunnel of every known path sharing
+// that prefix removed.
+void PathGenerator::add_deviations(const std::vector<int>& last) {
+    std::vector<int> spur;
+    for (size_t i = 0; i + 1 < last.size(); ++i) {
+        blocked_tunnels.clear();
+        for (const auto& path : found) {
+            if (path.size() > i + 1 && std::equal(last.begin(), last.begin() + i + 1, path.begin())) {
+                blocked_tunnels.push_back({path[i], path[i + 1]});
+            }
+        }
+
+        for (size_t j = 0; j < i; ++j) blocked_room[last[j]] = 1;
+
+        if (spur_path(last[i], spur)) {
+            std::vector<int> candidate(last.begin(), last.begin() + i);
+            candidate.insert(candidate.end(), spur.begin(), spur.end());
+            candidates.insert(make_candidate(std::move(candidate)));
+        }
+
+        for (size_t j = 0; j < i; ++j) blocked_room[last[j]] = 0;
+    }
+}
+
+bool PathGenerator::next(std::vector<int>& path) {
+    if (!started) {
+        started = true;
+        blocked_tunnels.clear();
+        if (spur_path(start_room, path)) {
+            candidates.insert(make_candidate(path));
+        }
+    } else if (!found.empty()) {
+        add_deviations(found.back());
+    }
+
+    if (candidates.empty()) return false;
+
+    path = candidates.begin()->path;
+    candidates.erase(candidates.begin());
+    found.push_back(path);
+    return true;
+}
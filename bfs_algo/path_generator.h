@@ -0,0 +1,52 @@
+#ifndef PATH_GENERATOR_H
+#define PATH_GENERATOR_H
+
+#include <vector>
+#include <set>
+
+// Lazily yields simple paths from start to end in the order simulate_dfs sorts them:
+// fewest rooms first, then highest total room capacity.
+//
+// Uses Yen's k-shortest-paths algorithm with a lexicographic (length, -capacity) cost,
+// so the k-th path costs k spur searches instead of enumerating every simple path.
+// Memory is bounded by the paths returned so far plus their candidate deviations.
+class PathGenerator {
+    struct Candidate {
+        int length;
+        long long capacity;
+        std::vector<int> path;
+
+        bool operator<(const Candidate& other) const {
+            if (length != other.length) return length < other.length;
+            if (capacity != other.capacity) return capacity > other.capacity;
+            return path < other.path;
+        }
+    };
+
+    const std::vector<std::vector<int>>& graph;
+    const std::vector<int>& room_capacity;
+    int start_room;
+    int end_room;
+
+    std::vector<std::vector<int>> found;  // Paths already returned (A in Yen's algorithm)
+    std::set<Candidate> candidates;       // Deviations not yet returned (B)
+    bool started = false;
+
+    // Scratch buffers for spur searches
+    std::vector<char> blocked_room;
+    std::vector<std::pair<int, int>> blocked_tunnels;
+
+    Candidate make_candidate(std::vector<int> path) const;
+    bool spur_path(int spur, std::vector<int>& path);
+    void add_deviations(const std::vector<int>& last);
+
+public:
+    // graph and room_capacity must outlive the generator
+    PathGenerator(const std::vector<std::vector<int>>& graph, const std::vector<int>& room_capacity,
+                  int start_room, int end_room);
+
+    // Writes the next path into path. Returns false once every simple path has been produced.
+    bool next(std::vector<int>& path);
+};
+
+#endif
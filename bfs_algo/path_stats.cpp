@@ -0,0 +1,100 @@
+#include "path_stats.h"
+#include <algorithm>
+#include <limits>
+#include <map>
+
+namespace {
+    const unsigned long long COUNT_MAX = std::numeric_limits<unsigned long long>::max();
+
+    // Saturating add so huge hills report "at least" instead of wrapping around
+    unsigned long long add_count(unsigned long long a, unsigned long long b, bool& saturated) {
+        if (a > COUNT_MAX - b) {
+            saturated = true;
+            return COUNT_MAX;
+        }
+        return a + b;
+    }
+
+    // Unweighted distances from `source`, and the rooms in the order they were reached
+    std::vector<int> bfs_layers(const std::vector<std::vector<int>>& graph, int source, std::vector<int>* order) {
+        std::vector<int> dist(graph.size(), -1);
+        std::vector<int> queue = {source};
+        dist[source] = 0;
+
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int room = queue[head];
+            for (int neighbor : graph[room]) {
+                if (dist[neighbor] < 0) {
+                    dist[neighbor] = dist[room] + 1;
+                    queue.push_back(neighbor);
+                }
+            }
+        }
+
+        if (order) *order = std::move(queue);
+        return dist;
+    }
+}
+
+PathStatistics analyze_shortest_paths(const std::vector<std::vector<int>>& graph,
+                                      const std::vector<int>& room_capacity,
+                                      int start_room, int end_room) {
+    PathStatistics stats;
+    const int rooms = static_cast<int>(graph.size());
+
+    std::vector<int> order;
+    std::vector<int> from_start = bfs_layers(graph, start_room, &order);
+
+    // Shortest route counts per room: sum over the previous BFS layer
+    stats.paths_to_room.assign(rooms, 0);
+    stats.paths_to_room[start_room] = 1;
+    for (int room : order) {
+        for (int neighbor : graph[room]) {
+            if (from_start[neighbor] == from_start[room] + 1) {
+                stats.paths_to_room[neighbor] = add_count(stats.paths_to_room[neighbor],
+                                                          stats.paths_to_room[room], stats.saturated);
+            }
+        }
+    }
+
+    if (from_start[end_room] < 0) return stats;
+
+    stats.shortest_steps = from_start[end_room];
+    stats.shortest_paths = stats.paths_to_room[end_room];
+
+    // Rooms lying on at least one shortest start -> dormitory route
+    std::vector<int> to_end = bfs_layers(graph, end_room, nullptr);
+    auto on_dag = [&](int room) {
+        return to_end[room] >= 0 && from_start[room] + to_end[room] == stats.shortest_steps;
+    };
+
+    // Per-room DP over the DAG: routes by bottleneck, and the total capacity range.
+    // A room's table is released as soon as all its successors have been updated.
+    std::vector<std::map<int, unsigned long long>> by_bottleneck(rooms);
+    std::vector<long long> min_total(rooms, std::numeric_limits<long long>::max());
+    std::vector<long long> max_total(rooms, std::numeric_limits<long long>::min());
+
+    by_bottleneck[start_room][room_capacity[start_room]] = 1;
+    min_total[start_room] = max_total[start_room] = room_capacity[start_room];
+
+    for (int room : order) {
+        if (room == end_room || !on_dag(room)) continue;
+
+        for (int neighbor : graph[room]) {
+            if (from_start[neighbor] != from_start[room] + 1 || !on_dag(neighbor)) continue;
+
+            for (const auto& [bottleneck, count] : by_bottleneck[room]) {
+                auto& slot = by_bottleneck[neighbor][std::min(bottleneck, room_capacity[neighbor])];
+                slot = add_count(slot, count, stats.saturated);
+            }
+            min_total[neighbor] = std::min(min_total[neighbor], min_total[room] + room_capacity[neighbor]);
+            max_total[neighbor] = std::max(max_total[neighbor], max_total[room] + room_capacity[neighbor]);
+        }
+        by_bottleneck[room].clear();
+    }
+
+    stats.bottleneck_distribution.assign(by_bottleneck[end_room].begin(), by_bottleneck[end_room].end());
+    stats.min_total_capacity = min_total[end_room];
+    stats.max_total_capacity = max_total[end_room];
+    return stats;
+}
@@ -0,0 +1,34 @@
+#ifndef PATH_STATS_H
+#define PATH_STATS_H
+
+#include <utility>
+#include <vector>
+
+// Route statistics computed by dynamic programming over BFS layers,
+// without building a single path.
+struct PathStatistics {
+    int shortest_steps = -1;                 // -1 if the dormitory is unreachable
+    unsigned long long shortest_paths = 0;   // Number of distinct shortest routes
+    bool saturated = false;                  // True if a count overflowed and was clamped
+
+    // Number of shortest routes from the start to each room (0 if unreachable)
+    std::vector<unsigned long long> paths_to_room;
+
+    // (bottleneck capacity, number of shortest routes whose smallest room has that capacity),
+    // by increasing capacity
+    std::vector<std::pair<int, unsigned long long>> bottleneck_distribution;
+
+    // Range of total room capacity over the shortest routes
+    long long min_total_capacity = 0;
+    long long max_total_capacity = 0;
+};
+
+// Counts shortest routes per room with BFS-layer DP, then walks the shortest-path DAG
+// (tunnels u -> v with dist_start[u] + 1 + dist_end[v] = shortest) in layer order to get
+// the bottleneck distribution. Runs in O((V + E) * C) time, C being the number of
+// distinct capacities seen on the DAG, and O(V * C) memory.
+PathStatistics analyze_shortest_paths(const std::vector<std::vector<int>>& graph,
+                                      const std::vector<int>& room_capacity,
+                                      int start_room, int end_room);
+
+#endif
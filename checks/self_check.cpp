@@ -0,0 +1,236 @@
+// Self-checking runs for the pieces the benchmark only prints: the tunnel hash
+// set, the varints of traces and checkpoints, LPA* replanning and checkpoint
+// restore. Prints each failure and exits non-zero if there was any (ctest).
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ants_dijkstra.h"
+#include "room_hills.h"
+#include "simulation_checkpoint.h"
+#include "tunnel_set.h"
+#include "varint.h"
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const std::string& what) {
+    if (!ok) {
+        std::cout << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+// Home slot of the a-b tunnel in a TunnelSet of `slots` slots (same key and
+// splitmix64 finalizer as tunnel_set.cpp), to pick tunnels that collide
+size_t home_slot(int a, int b, size_t slots) {
+    if (a > b) std::swap(a, b);
+    uint64_t key = (static_cast<uint64_t>(a) << 32) | static_cast<uint32_t>(b);
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return static_cast<size_t>(key) & (slots - 1);
+}
+
+// The first `count` tunnels 0-b whose home is `slot` of a 16-slot set
+std::vector<int> tunnels_homed_at(size_t slot, int count, int& next_room) {
+    std::vector<int> rooms;
+    while (static_cast<int>(rooms.size()) < count) {
+        next_room++;
+        if (home_slot(0, next_room, 16) == slot) rooms.push_back(next_room);
+    }
+    return rooms;
+}
+
+void check_tunnel_set_collisions() {
+    // Two tunnels at their home slots 0 and 1, then a run homed at the last two
+    // slots that wraps around behind them: erasing any one must move back exactly
+    // the entries its slot was keeping from their home, and leave the others
+    int room = 0;
+    std::vector<int> all = tunnels_homed_at(0, 2, room);
+    for (size_t slot : {14, 14, 15, 15}) {
+        all.push_back(tunnels_homed_at(slot, 1, room).front());
+    }
+
+    for (size_t erased = 0; erased < all.size(); erased++) {
+        TunnelSet set;
+        set.reserve(7);  // 16 slots, the size the homes were computed for
+        for (int b : all) check(set.insert(b, 0), "insert of a colliding tunnel");
+        check(!set.insert(0, all[0]), "insert of a colliding tunnel twice");
+        check(set.size() == all.size(), "size after colliding inserts");
+
+        check(set.erase(0, all[erased]), "erase of a colliding tunnel");
+        check(!set.erase(0, all[erased]), "erase of a colliding tunnel twice");
+        for (size_t i = 0; i < all.size(); i++) {
+            check(set.contains(all[i], 0) == (i != erased),
+                  "contains after erasing tunnel " + std::to_string(erased) + " of a wrapped run");
+        }
+        check(set.size() == all.size() - 1, "size after erasing from a wrapped run");
+    }
+}
+
+void check_tunnel_set_random() {
+    // Random inserts and erases over few rooms, so runs are long and keep growing
+    // and shrinking across the end of the table, against std::set
+    std::mt19937 random(12345);
+    TunnelSet set;
+    std::set<std::pair<int, int>> expected;
+    for (int op = 0; op < 200000; op++) {
+        int a = static_cast<int>(random() % 40);
+        int b = static_cast<int>(random() % 40);
+        std::pair<int, int> tunnel(std::min(a, b), std::max(a, b));
+        if (random() % 3 == 0) {
+            check(set.erase(a, b) == (expected.erase(tunnel) == 1), "random erase");
+        } else {
+            check(set.insert(a, b) == expected.insert(tunnel).second, "random insert");
+        }
+        if (failures > 0) return;
+    }
+    check(set.size() == expected.size(), "size after random operations");
+    for (int a = 0; a < 40; a++) {
+        for (int b = 0; b < 40; b++) {
+            check(set.contains(a, b) == (expected.count({std::min(a, b), std::max(a, b)}) == 1),
+                  "contains after random operations");
+        }
+    }
+}
+
+void check_varints() {
+    const uint64_t unsigned_values[] = {0, 1, 127, 128, 16383, 16384, (1ULL << 32) - 1, 1ULL << 32,
+                                        (1ULL << 63) - 1, 1ULL << 63, std::numeric_limits<uint64_t>::max()};
+    const size_t unsigned_bytes[] = {1, 1, 1, 2, 2, 3, 5, 5, 9, 10, 10};
+    for (size_t i = 0; i < std::size(unsigned_values); i++) {
+        std::vector<uint8_t> bytes;
+        put_varint(bytes, unsigned_values[i]);
+        check(bytes.size() == unsigned_bytes[i], "varint length of " + std::to_string(unsigned_values[i]));
+
+        size_t position = 0;
+        uint64_t value = 0;
+        check(get_varint(bytes.data(), bytes.size(), position, value) && value == unsigned_values[i] &&
+                  position == bytes.size(),
+              "varint round-trip of " + std::to_string(unsigned_values[i]));
+
+        position = 0;
+        check(!get_varint(bytes.data(), bytes.size() - 1, position, value),
+              "truncated varint of " + std::to_string(unsigned_values[i]));
+    }
+
+    const int64_t signed_values[] = {0, -1, 1, -2, 63, -64, 64, -65,
+                                     std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min()};
+    const size_t signed_bytes[] = {1, 1, 1, 1, 1, 1, 2, 2, 10, 10};
+    std::vector<uint8_t> stream;
+    for (size_t i = 0; i < std::size(signed_values); i++) {
+        std::vector<uint8_t> bytes;
+        put_zigzag(bytes, signed_values[i]);
+        check(bytes.size() == signed_bytes[i], "zigzag length of " + std::to_string(signed_values[i]));
+        put_zigzag(stream, signed_values[i]);
+    }
+
+    // Read back one after the other, as traces and checkpoints do
+    size_t position = 0;
+    for (int64_t expected : signed_values) {
+        int64_t value = 0;
+        check(get_zigzag(stream.data(), stream.size(), position, value) && value == expected,
+              "zigzag round-trip of " + std::to_string(expected));
+    }
+    check(position == stream.size(), "zigzag stream read to its end");
+}
+
+void check_replan() {
+    // LPA* against a search from scratch while tunnels collapse, reopen and rooms
+    // change capacity
+    RoomHill hill = make_cave_hill(40, 8, 500, 7);
+    AnthillDijkstra anthill = hill.build<AnthillDijkstra>();
+    anthill.set_verbose(false);
+    DijkstraWorkspace workspace;
+    std::vector<int> path;
+    std::mt19937 random(99);
+
+    std::vector<std::pair<int, int>> removed;
+    for (int change = 0; change < 300; change++) {
+        int kind = static_cast<int>(random() % 3);
+        if (kind == 0 || removed.empty()) {
+            const auto& tunnel = hill.tunnels[random() % hill.tunnels.size()];
+            if (anthill.remove_tunnel(tunnel.first, tunnel.second)) removed.push_back(tunnel);
+        } else if (kind == 1) {
+            size_t index = random() % removed.size();
+            anthill.add_tunnels(removed[index].first, removed[index].second);
+            removed.erase(removed.begin() + static_cast<long>(index));
+        } else {
+            int room = 1 + static_cast<int>(random() % (hill.rooms() - 2));
+            anthill.set_room_capacity(room, 1 + static_cast<int>(random() % 5));
+        }
+
+        int expected = anthill.find_best_path(workspace, path);
+        int replanned = anthill.replan(path);
+        check(replanned == expected, "replan after change " + std::to_string(change) + ": " +
+                                         std::to_string(replanned) + " instead of " + std::to_string(expected));
+        if (expected >= 0) {
+            check(!path.empty() && path.front() == 0 && path.back() == hill.rooms() - 1,
+                  "replanned route from the start to the dormitory");
+        }
+    }
+}
+
+void check_checkpoint_restore() {
+    RoomHill hill = make_cave_hill(200, 20, 20000, 3);
+    AnthillDijkstra anthill = hill.build<AnthillDijkstra>();
+    SimulationStepper plain = anthill.disjoint_simulation(4);
+    while (plain.advance()) {}
+
+    SimulationStepper first_half = anthill.disjoint_simulation(4);
+    for (int step = 0; step < plain.steps() / 2; step++) first_half.advance();
+
+    const std::string path = (std::filesystem::temp_directory_path() / "MyAntAcademy_self_check.ckpt").string();
+    std::string error;
+    check(save_checkpoint(first_half, path, error), "save_checkpoint: " + error);
+
+    SimulationStepper resumed;
+    check(load_checkpoint(path, resumed, error), "load_checkpoint: " + error);
+    check(resumed.steps() == first_half.steps() && resumed.occupancy() == first_half.occupancy(),
+          "restored stepper at the saved step");
+    while (resumed.advance()) {}
+    check(resumed.result() == plain.result() && resumed.occupancy() == plain.occupancy(),
+          "resumed run ends like the plain one");
+
+    // A flipped byte must be refused by the checksum, leaving the stepper as it was
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        char byte = 0;
+        file.seekg(20);
+        file.get(byte);
+        file.seekp(20);
+        file.put(static_cast<char>(byte ^ 0x5a));
+    }
+    SimulationStepper untouched;
+    check(!load_checkpoint(path, untouched, error), "damaged checkpoint refused");
+    check(untouched.done() && untouched.result() == -1, "damaged checkpoint leaves the stepper unchanged");
+    std::remove(path.c_str());
+}
+
+}  // namespace
+
+int main() {
+    check_tunnel_set_collisions();
+    check_tunnel_set_random();
+    check_varints();
+    check_replan();
+    check_checkpoint_restore();
+
+    if (failures > 0) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,98 @@
+#ifndef COMPACT_GRAPH_H
+#define COMPACT_GRAPH_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// Read-only copy of a hill's tunnels in compressed sparse row form, with room ids
+// stored as Index (uint16_t or uint32_t). Usable as the Graph policy of
+// best_first_search.
+//
+// The neighbours of room r are targets[offsets[r] .. offsets[r + 1]): one array
+// for the whole hill instead of a heap block per room, and half the bytes per id
+// with uint16_t. On hills of a million rooms a search then streams a few
+// contiguous megabytes instead of chasing a pointer per expansion. The solvers
+// keep their adjacency lists, which add_tunnels and remove_tunnel edit in place;
+// build a CompactGraph once the hill no longer changes.
+template <typename Index>
+class CompactGraph {
+    std::vector<uint32_t> offsets;  // rooms + 1 entries
+    std::vector<Index> targets;
+
+public:
+    // Largest number of rooms Index can number
+    static constexpr size_t MAX_ROOMS = static_cast<size_t>(std::numeric_limits<Index>::max()) + 1;
+
+    explicit CompactGraph(const std::vector<std::vector<int>>& rooms) : offsets(rooms.size() + 1, 0) {
+        size_t tunnel_ends = 0;
+        for (size_t room = 0; room < rooms.size(); room++) {
+            tunnel_ends += rooms[room].size();
+            assert(tunnel_ends <= std::numeric_limits<uint32_t>::max() && "offsets overflow past 2^32 tunnel ends");
+            offsets[room + 1] = static_cast<uint32_t>(tunnel_ends);
+        }
+        targets.reserve(tunnel_ends);
+        for (const std::vector<int>& neighbors : rooms) {
+            for (int next : neighbors) targets.push_back(static_cast<Index>(next));
+        }
+    }
+
+    int size() const { return static_cast<int>(offsets.size()) - 1; }
+    size_t tunnel_ends() const { return targets.size(); }
+
+    template <typename Visit>
+    void for_each_neighbor(int room, Visit&& visit) const {
+        const Index* next = targets.data() + offsets[room];
+        const Index* end = targets.data() + offsets[room + 1];
+        for (; next != end; ++next) visit(static_cast<int>(*next));
+    }
+
+    size_t memory_bytes() const {
+        return offsets.capacity() * sizeof(uint32_t) + targets.capacity() * sizeof(Index);
+    }
+};
+
+// Bytes per room id a hill of `rooms` rooms needs: 2 up to 65536 rooms, else 4
+inline int compact_index_bytes(size_t rooms) {
+    return rooms <= CompactGraph<uint16_t>::MAX_ROOMS ? 2 : 4;
+}
+
+// Builds the narrowest CompactGraph that can number the hill's rooms and returns
+// visit(graph). visit is instantiated for both widths, so it is typically a
+// generic lambda running the search.
+template <typename Visit>
+auto with_compact_graph(const std::vector<std::vector<int>>& rooms, Visit&& visit) {
+    if (compact_index_bytes(rooms.size()) == 2) {
+        return visit(CompactGraph<uint16_t>(rooms));
+    }
+    return visit(CompactGraph<uint32_t>(rooms));
+}
+
+// with_compact_graph for a hill that never changes and is searched many times:
+// the narrowest CompactGraph is built once and visit() hands it to each search.
+class CompactGraphSnapshot {
+    std::variant<CompactGraph<uint16_t>, CompactGraph<uint32_t>> graph;
+
+    static decltype(graph) build(const std::vector<std::vector<int>>& rooms) {
+        if (compact_index_bytes(rooms.size()) == 2) return CompactGraph<uint16_t>(rooms);
+        return CompactGraph<uint32_t>(rooms);
+    }
+
+public:
+    explicit CompactGraphSnapshot(const std::vector<std::vector<int>>& rooms) : graph(build(rooms)) {}
+
+    template <typename Visit>
+    auto visit(Visit&& visit) const {
+        return std::visit(std::forward<Visit>(visit), graph);
+    }
+
+    size_t memory_bytes() const {
+        return visit([](const auto& compact) { return compact.memory_bytes(); });
+    }
+};
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef NULL_STREAM_H
+#define NULL_STREAM_H
+
+#include <ostream>
+
+// An ostream with no buffer: every write fails silently and is dropped.
+//
+// Each solver owns one for its quiet mode. A single static shared by all solvers
+// of a class would be written (format flags, state bits) from every thread that
+// runs a quiet simulation at the same time. Copies start fresh, so the solvers
+// holding one stay copyable.
+class NullStream : public std::ostream {
+public:
+    NullStream() : std::ostream(nullptr) {}
+    NullStream(const NullStream&) : NullStream() {}
+    NullStream& operator=(const NullStream&) { return *this; }
+};
+
+#endif
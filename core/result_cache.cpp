@@ -0,0 +1,164 @@
+#include "result_cache.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace {
+    // Two independent 64-bit hashes fed with the same words: FNV-1a over the bytes
+    // and a multiply-xorshift mix over whole words
+    class KeyBuilder {
+        uint64_t fnv = 0xcbf29ce484222325ULL;
+        uint64_t mix = 0x243f6a8885a308d3ULL;
+
+    public:
+        KeyBuilder() = default;
+        explicit KeyBuilder(const CacheKey& start) : fnv(start.low), mix(start.high) {}
+
+        void add(uint64_t word) {
+            for (int byte = 0; byte < 8; byte++) {
+                fnv ^= (word >> (8 * byte)) & 0xff;
+                fnv *= 0x100000001b3ULL;
+            }
+            mix = (mix ^ word) * 0x9e3779b97f4a7c15ULL;
+            mix ^= mix >> 29;
+        }
+
+        void add(const std::string& text) {
+            add(text.size());
+            for (unsigned char c : text) add(static_cast<uint64_t>(c));
+        }
+
+        CacheKey key() const { return {fnv, mix}; }
+    };
+}
+
+std::string CacheKey::hex() const {
+    std::ostringstream out;
+    out << std::hex << std::setfill('0') << std::setw(16) << high << std::setw(16) << low;
+    return out.str();
+}
+
+double CacheStats::hit_rate() const {
+    long long lookups = memory_hits + disk_hits + misses;
+    return lookups == 0 ? 0.0 : static_cast<double>(memory_hits + disk_hits) / lookups;
+}
+
+ResultCache::ResultCache(size_t capacity, std::string directory)
+    : capacity(std::max<size_t>(1, capacity)), directory(std::move(directory)) {
+    if (!this->directory.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(this->directory, error);  // load/store fail quietly if this did
+    }
+}
+
+CacheKey ResultCache::hash_hill(const RoomHill& hill) {
+    KeyBuilder builder;
+    builder.add(VERSION);
+    builder.add(static_cast<uint64_t>(hill.ants));
+    builder.add(hill.capacities.size());
+    for (int capacity : hill.capacities) builder.add(static_cast<uint64_t>(static_cast<uint32_t>(capacity)));
+    builder.add(hill.tunnels.size());
+    for (const auto& [a, b] : hill.tunnels) {
+        builder.add((static_cast<uint64_t>(static_cast<uint32_t>(a)) << 32) | static_cast<uint32_t>(b));
+    }
+    return builder.key();
+}
+
+int ResultCache::get_or_compute(const CacheKey& hill, const std::string& query,
+                                const std::function<int()>& compute) {
+    KeyBuilder builder(hill);
+    builder.add(query);
+    const CacheKey key = builder.key();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = index.find(key);
+        if (found != index.end()) {
+            Entry entry = *found->second;
+            remember(entry);
+            counters.memory_hits++;
+            counters.saved_ms += entry.compute_ms;
+            return entry.result;
+        }
+    }
+
+    Entry entry;
+    if (load(key, entry)) {
+        std::lock_guard<std::mutex> lock(mutex);
+        remember(entry);
+        counters.disk_hits++;
+        counters.saved_ms += entry.compute_ms;
+        return entry.result;
+    }
+
+    // Computed outside the lock: concurrent misses on one key may both compute it
+    auto start = std::chrono::steady_clock::now();
+    entry = {key, compute(), 0.0};
+    auto end = std::chrono::steady_clock::now();
+    entry.compute_ms = std::chrono::duration<double, std::milli>(end - start).count();
+    store(entry);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    remember(entry);
+    counters.misses++;
+    counters.computed_ms += entry.compute_ms;
+    return entry.result;
+}
+
+void ResultCache::remember(const Entry& entry) {
+    auto found = index.find(entry.key);
+    if (found != index.end()) {
+        recent.erase(found->second);
+    } else if (recent.size() >= capacity) {
+        index.erase(recent.back().key);
+        recent.pop_back();
+    }
+    recent.push_front(entry);
+    index[entry.key] = recent.begin();
+}
+
+bool ResultCache::load(const CacheKey& key, Entry& entry) const {
+    if (directory.empty()) return false;
+
+    std::ifstream file(directory + "/" + key.hex() + ".result");
+    std::string stored_key;
+    if (!(file >> stored_key >> entry.result >> entry.compute_ms) || stored_key != key.hex()) {
+        return false;
+    }
+    entry.key = key;
+    return true;
+}
+
+void ResultCache::store(const Entry& entry) const {
+    if (directory.empty()) return;
+
+    // Written aside then renamed, so a concurrent reader never sees half a file
+    std::string path = directory + "/" + entry.key.hex() + ".result";
+    std::string temporary = path + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    {
+        std::ofstream file(temporary);
+        file << entry.key.hex() << " " << entry.result << " " << entry.compute_ms << "\n";
+        if (!file) return;
+    }
+    std::rename(temporary.c_str(), path.c_str());
+}
+
+CacheStats ResultCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+std::string ResultCache::summary() const {
+    CacheStats s = stats();
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1)
+        << s.memory_hits << " memory hits, " << s.disk_hits << " disk hits, " << s.misses << " misses ("
+        << 100.0 * s.hit_rate() << "% hit rate), " << std::setprecision(3)
+        << s.computed_ms << " ms computed, " << s.saved_ms << " ms saved";
+    return out.str();
+}
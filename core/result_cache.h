@@ -0,0 +1,85 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "room_hills.h"
+
+// 128-bit content hash of a hill, or of a hill and a query
+struct CacheKey {
+    uint64_t low = 0;
+    uint64_t high = 0;
+
+    bool operator==(const CacheKey& other) const { return low == other.low && high == other.high; }
+    std::string hex() const;
+};
+
+struct CacheStats {
+    long long memory_hits = 0;
+    long long disk_hits = 0;
+    long long misses = 0;
+    double computed_ms = 0.0;  // Time spent in the solvers on misses
+    double saved_ms = 0.0;     // Solver time the hits would have cost, as measured on their miss
+
+    double hit_rate() const;
+};
+
+// Memoizes solver results (step counts) by hill content and query.
+//
+// The key hashes VERSION, the ant count, every room capacity and every tunnel in
+// the order it was added, then the query ("simulate_dijkstra", "makespan", ...).
+// Tunnel order is kept on purpose: the solvers break ties by adjacency order, so
+// the same tunnels listed differently may legitimately give another answer. Two
+// 64-bit hashes with different mixing make accidental collisions negligible.
+//
+// Recent results live in an LRU of `capacity` entries. With a directory, every
+// result is also written there as one small file per key and looked up on a
+// memory miss, so results survive restarts. Thread-safe.
+class ResultCache {
+public:
+    // Mixed into every key. Bump it when a solver may now answer a query differently
+    // or the file format changes, so a shared directory never serves older results.
+    static constexpr uint64_t VERSION = 1;
+
+    explicit ResultCache(size_t capacity, std::string directory = "");
+
+    // Hash of a hill, to compute once per hill rather than once per query
+    static CacheKey hash_hill(const RoomHill& hill);
+
+    // Result of `query` on the hill, running compute() only if it is not cached
+    int get_or_compute(const CacheKey& hill, const std::string& query, const std::function<int()>& compute);
+
+    CacheStats stats() const;
+
+    // One-line summary: hits, misses, hit rate, solver time spent and saved
+    std::string summary() const;
+
+private:
+    struct KeyHash {
+        size_t operator()(const CacheKey& key) const { return static_cast<size_t>(key.low); }
+    };
+
+    struct Entry {
+        CacheKey key;
+        int result;
+        double compute_ms;
+    };
+
+    size_t capacity;
+    std::string directory;
+    std::list<Entry> recent;  // Most recently used first
+    std::unordered_map<CacheKey, std::list<Entry>::iterator, KeyHash> index;
+    CacheStats counters;
+    mutable std::mutex mutex;
+
+    // Moves the entry to the front of the LRU, evicting the oldest one if full
+    void remember(const Entry& entry);
+    bool load(const CacheKey& key, Entry& entry) const;
+    void store(const Entry& entry) const;
+};
+
+#endif
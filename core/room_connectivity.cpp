@@ -0,0 +1,39 @@
+#include "room_connectivity.h"
+#include <numeric>
+#include <utility>
+
+RoomConnectivity::RoomConnectivity(int rooms) : parent(rooms), size(rooms, 1), count(rooms) {
+    std::iota(parent.begin(), parent.end(), 0);
+}
+
+int RoomConnectivity::find_halving(int room) {
+    while (parent[room] != room) {
+        parent[room] = parent[parent[room]];
+        room = parent[room];
+    }
+    return room;
+}
+
+int RoomConnectivity::component(int room) const {
+    while (parent[room] != room) room = parent[room];
+    return room;
+}
+
+void RoomConnectivity::connect(int a, int b) {
+    a = find_halving(a);
+    b = find_halving(b);
+    if (a == b) return;
+    if (size[a] < size[b]) std::swap(a, b);
+    parent[b] = a;
+    size[a] += size[b];
+    count--;
+}
+
+void RoomConnectivity::rebuild(const std::vector<std::vector<int>>& graph) {
+    *this = RoomConnectivity(static_cast<int>(graph.size()));
+    for (int room = 0; room < static_cast<int>(graph.size()); room++) {
+        for (int next : graph[room]) {
+            if (next > room) connect(room, next);
+        }
+    }
+}
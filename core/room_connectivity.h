@@ -0,0 +1,36 @@
+#ifndef ROOM_CONNECTIVITY_H
+#define ROOM_CONNECTIVITY_H
+
+#include <vector>
+
+// Which rooms are joined by tunnels, kept up to date as tunnels are added.
+//
+// A union-find forest with union by size: connect() is near-constant time, and
+// queries walk at most log2(rooms) parents. Queries never compress paths, so
+// const callers on several threads can ask at once; connect() halves the paths
+// it walks instead. Tunnels cannot be removed from a union-find: after a removal
+// the owner rebuilds it from the adjacency lists.
+class RoomConnectivity {
+public:
+    explicit RoomConnectivity(int rooms = 0);
+
+    void connect(int a, int b);
+
+    // Back to one component per room, then every tunnel of graph
+    void rebuild(const std::vector<std::vector<int>>& graph);
+
+    // Representative room of the component holding room
+    int component(int room) const;
+    bool connected(int a, int b) const { return component(a) == component(b); }
+    int component_size(int room) const { return size[component(room)]; }
+    int components() const { return count; }
+
+private:
+    std::vector<int> parent;
+    std::vector<int> size;  // Rooms under each representative
+    int count = 0;
+
+    int find_halving(int room);
+};
+
+#endif
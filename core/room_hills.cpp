@@ -0,0 +1,102 @@
+#include "room_hills.h"
+#include <random>
+
+std::vector<std::vector<int>> RoomHill::adjacency() const {
+    std::vector<std::vector<int>> graph(rooms());
+    for (const auto& [a, b] : tunnels) {
+        graph[a].push_back(b);
+        graph[b].push_back(a);
+    }
+    return graph;
+}
+
+const std::vector<RoomHill>& room_hills() {
+    static const std::vector<RoomHill> hills = {
+        {"Small Hill (4 rooms)", 2,
+         {2, 1, 1, 2},
+         {{0, 1}, {0, 2}, {1, 3}, {2, 3}}},
+        {"Medium Hill 1 (4 rooms)", 5,
+         {5, 1, 1, 5},
+         {{0, 1}, {1, 2}, {2, 3}}},
+        {"Medium Hill 2 (4 rooms, loop)", 5,
+         {5, 1, 1, 5},
+         {{0, 1}, {1, 2}, {2, 3}, {0, 3}}},
+        {"Medium Hill 3 (6 rooms)", 5,
+         {5, 1, 1, 1, 1, 5},
+         {{0, 1}, {1, 2}, {4, 5}, {1, 4}, {2, 3}}},
+        {"Large Hill (8 rooms)", 10,
+         {10, 2, 1, 1, 2, 2, 1, 10},
+         {{3, 4}, {0, 1}, {1, 2}, {2, 4}, {4, 5}, {5, 7}, {4, 6}, {6, 7}, {1, 3}}},
+        {"Extra Large Hill (16 rooms)", 50,
+         {50, 8, 4, 2, 4, 2, 4, 2, 5, 1, 1, 1, 1, 4, 12, 50},
+         {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 15}, {1, 6}, {6, 8}, {8, 12}, {12, 13},
+          {13, 15}, {2, 5}, {5, 4}, {6, 7}, {7, 10}, {10, 14}, {14, 15}, {3, 9},
+          {9, 11}, {11, 15}}},
+        {"King Hill (23 rooms)", 100,
+         {100, 50, 50, 50, 1, 1, 3, 3, 7, 5, 5, 3, 3, 10, 20, 1, 1, 30, 10, 5, 5, 30, 100},
+         {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}, {5, 22}, {0, 6}, {6, 7}, {7, 8},
+          {8, 9}, {9, 10}, {10, 22}, {0, 11}, {11, 12}, {12, 13}, {13, 14}, {14, 15},
+          {15, 22}, {0, 16}, {16, 17}, {17, 18}, {18, 19}, {19, 20}, {20, 22}, {21, 3},
+          {21, 8}, {21, 13}, {21, 18}}},
+    };
+    return hills;
+}
+
+RoomHill make_cave_hill(int layers, int width, int ants, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> capacity(1, 5);
+    std::bernoulli_distribution cross(0.5);
+
+    RoomHill hill;
+    hill.name = "Cave (" + std::to_string(layers * width + 2) + " rooms)";
+    hill.ants = ants;
+
+    int total_rooms = layers * width + 2;
+    int dormitory = total_rooms - 1;
+    auto room = [width](int layer, int i) { return 1 + layer * width + i; };
+
+    hill.capacities.assign(total_rooms, 0);
+    hill.capacities[0] = ants;
+    hill.capacities[dormitory] = ants;
+    for (int r = 1; r < dormitory; r++) {
+        hill.capacities[r] = capacity(rng);
+    }
+
+    for (int i = 0; i < width; i++) {
+        hill.tunnels.push_back({0, room(0, i)});
+        hill.tunnels.push_back({room(layers - 1, i), dormitory});
+    }
+    for (int layer = 0; layer + 1 < layers; layer++) {
+        for (int i = 0; i < width; i++) {
+            hill.tunnels.push_back({room(layer, i), room(layer + 1, i)});
+            if (width > 1 && cross(rng)) {
+                hill.tunnels.push_back({room(layer, i), room(layer + 1, (i + 1) % width)});
+            }
+        }
+    }
+    return hill;
+}
+
+RoomHill make_random_hill(int rooms, int tunnels_per_room, int ants, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> capacity(1, 5);
+    std::uniform_int_distribution<int> any_room(0, rooms - 1);
+
+    RoomHill hill;
+    hill.name = "Random (" + std::to_string(rooms) + " rooms)";
+    hill.ants = ants;
+
+    hill.capacities.resize(rooms);
+    for (int& c : hill.capacities) c = capacity(rng);
+    hill.capacities[0] = ants;
+    hill.capacities[rooms - 1] = ants;
+
+    long long tunnels = static_cast<long long>(rooms) * tunnels_per_room / 2;
+    hill.tunnels.reserve(tunnels);
+    for (long long t = 0; t < tunnels; t++) {
+        int a = any_room(rng);
+        int b = any_room(rng);
+        if (a != b) hill.tunnels.push_back({a, b});
+    }
+    return hill;
+}
@@ -0,0 +1,43 @@
+#ifndef ROOM_HILLS_H
+#define ROOM_HILLS_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// Room/tunnel description of an anthill, as built by the bfs, astar and dijkstra mains.
+// Room 0 is the start and the last room the dormitory.
+struct RoomHill {
+    std::string name;
+    int ants = 0;
+    std::vector<int> capacities;             // One per room
+    std::vector<std::pair<int, int>> tunnels;
+
+    int rooms() const { return static_cast<int>(capacities.size()); }
+    std::vector<std::vector<int>> adjacency() const;
+
+    // Builds any of Anthill, AnthillAStar or AnthillDijkstra from this description
+    template <typename Solver>
+    Solver build() const {
+        Solver solver(rooms(), ants);
+        for (int room = 0; room < rooms(); room++) {
+            solver.set_room_capacity(room, capacities[room]);
+        }
+        solver.add_tunnels(tunnels);
+        return solver;
+    }
+};
+
+// The seven hills from the room-based mains (Small Hill ... King Hill)
+const std::vector<RoomHill>& room_hills();
+
+// Deterministic cave of `layers` layers of `width` rooms with capacities 1 to 5,
+// each room linked to the same room of the next layer and, one time in two,
+// to its neighbour
+RoomHill make_cave_hill(int layers, int width, int ants, unsigned seed);
+
+// Deterministic hill of `rooms` rooms joined by rooms * tunnels_per_room / 2 random
+// tunnels: few steps across, unlike the caves
+RoomHill make_random_hill(int rooms, int tunnels_per_room, int ants, unsigned seed);
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef SEARCH_CORE_H
+#define SEARCH_CORE_H
+
+#include <vector>
+#include "search_workspace.h"
+
+// Policies for best_first_search. Each is a plain type picked at compile time,
+// so every solver gets its own specialized loop with no virtual call in it.
+//
+//  - Graph:     int size() const, and for_each_neighbor(room, visit) calling
+//               visit(next) for every room reachable in one move
+//  - Queue:     BinaryHeap or FifoQueue, through the SearchWorkspace it sits in
+//  - Cost:      int operator()(int from, int to) const, positive
+//  - Heuristic: int operator()(int room) const, estimated distance left to the goal
+
+// Graph policy over the room adjacency lists of the anthill solvers
+class AdjacencyList {
+    const std::vector<std::vector<int>>& rooms;
+
+public:
+    explicit AdjacencyList(const std::vector<std::vector<int>>& rooms) : rooms(rooms) {}
+
+    int size() const { return static_cast<int>(rooms.size()); }
+
+    template <typename Visit>
+    void for_each_neighbor(int room, Visit&& visit) const {
+        for (int next : rooms[room]) visit(next);
+    }
+};
+
+// Cost policy: every tunnel takes one step
+struct UnitCost {
+    int operator()(int, int) const { return 1; }
+};
+
+// Heuristic policy for uninformed searches (BFS, Dijkstra)
+struct NoHeuristic {
+    int operator()(int) const { return 0; }
+};
+
+// Shortest route from start to goal, settling rooms by increasing
+// distance + heuristic. Returns the distance, or -1 if goal cannot be reached.
+//
+// A room is expanded at most once and relaxed only while unvisited and strictly
+// improved, so with a consistent heuristic (or none) the distance is exact. path,
+// if given, receives the route; expanded, if given, the number of rooms expanded.
+template <typename Graph, typename Queue, typename Cost = UnitCost, typename Heuristic = NoHeuristic>
+int best_first_search(const Graph& graph, int start, int goal, SearchWorkspace<Queue>& workspace,
+                      std::vector<int>* path = nullptr, long long* expanded = nullptr,
+                      const Cost& cost = Cost(), const Heuristic& heuristic = Heuristic()) {
+    workspace.reset(graph.size());
+    workspace.relax(start, 0, -1);
+    workspace.push(start, heuristic(start));
+    if (expanded) *expanded = 0;
+
+    while (!workspace.queue_empty()) {
+        int room = workspace.pop().room;
+        if (workspace.is_visited(room)) {
+            continue;
+        }
+
+        workspace.mark_visited(room);
+        if (expanded) (*expanded)++;
+
+        if (room == goal) {
+            if (path) workspace.build_path(goal, *path);
+            return workspace.distance(goal);
+        }
+
+        const int distance = workspace.distance(room);
+        graph.for_each_neighbor(room, [&](int next) {
+            if (workspace.is_visited(next)) return;
+            int new_distance = distance + cost(room, next);
+            if (new_distance < workspace.distance(next)) {
+                workspace.relax(next, new_distance, room);
+                workspace.push(next, new_distance + heuristic(next));
+            }
+        });
+    }
+
+    if (path) path->clear();
+    return -1;
+}
+
+#endif
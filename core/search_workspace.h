@@ -0,0 +1,156 @@
+#ifndef SEARCH_WORKSPACE_H
+#define SEARCH_WORKSPACE_H
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+// Frontier entry shared by the queue policies
+struct SearchQueueEntry {
+    int distance;  // Priority: distance, or distance + heuristic for A*
+    int room;
+
+    // Ties are broken by room id so the result does not depend on heap layout
+    bool operator>(const SearchQueueEntry& other) const {
+        return distance != other.distance ? distance > other.distance : room > other.room;
+    }
+};
+
+// Queue policy for weighted searches: a binary min-heap on (priority, room)
+class BinaryHeap {
+    std::vector<SearchQueueEntry> entries;
+
+public:
+    void push(int room, int priority) {
+        entries.push_back({priority, room});
+        std::push_heap(entries.begin(), entries.end(), std::greater<>());
+    }
+
+    SearchQueueEntry pop() {
+        std::pop_heap(entries.begin(), entries.end(), std::greater<>());
+        SearchQueueEntry top = entries.back();
+        entries.pop_back();
+        return top;
+    }
+
+    bool empty() const { return entries.empty(); }
+    void clear() { entries.clear(); }
+    size_t memory_bytes() const { return entries.capacity() * sizeof(SearchQueueEntry); }
+};
+
+// Queue policy for unit-cost searches without a heuristic: plain BFS order.
+// Entries come out in push order, which is priority order when every tunnel costs 1.
+class FifoQueue {
+    std::vector<SearchQueueEntry> entries;
+    size_t head = 0;
+
+public:
+    void push(int room, int priority) { entries.push_back({priority, room}); }
+    SearchQueueEntry pop() { return entries[head++]; }
+    bool empty() const { return head == entries.size(); }
+
+    void clear() {
+        entries.clear();
+        head = 0;
+    }
+
+    size_t memory_bytes() const { return entries.capacity() * sizeof(SearchQueueEntry); }
+};
+
+// Scratch buffers for shortest path queries, kept alive between searches.
+//
+// Distances, predecessors and the visited set are generation-stamped: an entry is
+// only valid if its stamp matches the current generation, so reset() is O(1)
+// instead of refilling every array. The frontier is the Queue policy, whose
+// storage is cleared but never released, and paths are rebuilt from predecessors
+// into a reused buffer. Once the buffers have grown to the size of a hill, further
+// queries on it do not touch the heap allocator.
+template <typename Queue>
+class SearchWorkspace {
+public:
+    using QueueEntry = SearchQueueEntry;
+
+    static constexpr int UNREACHED = std::numeric_limits<int>::max();
+
+    // Prepares the workspace for a search over total_rooms rooms
+    void reset(int total_rooms) {
+        if (static_cast<int>(distances.size()) < total_rooms) {
+            distances.resize(total_rooms);
+            previous.resize(total_rooms);
+            distance_stamp.resize(total_rooms, 0);
+            visited_stamp.resize(total_rooms, 0);
+        }
+
+        // On wrap-around, stale stamps could collide with the new generation
+        if (++generation == 0) {
+            std::fill(distance_stamp.begin(), distance_stamp.end(), 0);
+            std::fill(visited_stamp.begin(), visited_stamp.end(), 0);
+            generation = 1;
+        }
+        queue.clear();
+    }
+
+    int distance(int room) const {
+        return distance_stamp[room] == generation ? distances[room] : UNREACHED;
+    }
+
+    int predecessor(int room) const {
+        return distance_stamp[room] == generation ? previous[room] : -1;
+    }
+
+    void relax(int room, int distance, int from) {
+        distances[room] = distance;
+        previous[room] = from;
+        distance_stamp[room] = generation;
+    }
+
+    bool is_visited(int room) const {
+        return visited_stamp[room] == generation;
+    }
+
+    void mark_visited(int room) {
+        visited_stamp[room] = generation;
+    }
+
+    void push(int room, int distance) {
+        queue.push(room, distance);
+    }
+
+    QueueEntry pop() {
+        return queue.pop();
+    }
+
+    bool queue_empty() const {
+        return queue.empty();
+    }
+
+    // Heap memory held by the buffers
+    size_t memory_bytes() const {
+        return distances.capacity() * sizeof(int) + previous.capacity() * sizeof(int) +
+               distance_stamp.capacity() * sizeof(unsigned) + visited_stamp.capacity() * sizeof(unsigned) +
+               queue.memory_bytes();
+    }
+
+    // Writes the route from the search source to `room` into path
+    void build_path(int room, std::vector<int>& path) const {
+        path.clear();
+        for (int r = room; r != -1; r = predecessor(r)) {
+            path.push_back(r);
+        }
+        std::reverse(path.begin(), path.end());
+    }
+
+private:
+    std::vector<int> distances;
+    std::vector<int> previous;
+    std::vector<unsigned> distance_stamp;
+    std::vector<unsigned> visited_stamp;
+    Queue queue;
+    unsigned generation = 0;
+};
+
+using DijkstraWorkspace = SearchWorkspace<BinaryHeap>;
+using BfsWorkspace = SearchWorkspace<FifoQueue>;
+
+#endif
@@ -0,0 +1,101 @@
+#include "simulation_checkpoint.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace {
+    const char MAGIC[8] = {'A', 'N', 'T', 'C', 'K', 'P', '1', '\n'};
+
+    uint64_t checksum(const uint8_t* data, size_t size) {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (size_t i = 0; i < size; i++) {
+            hash ^= data[i];
+            hash *= 0x100000001b3ULL;
+        }
+        return hash;
+    }
+}
+
+bool save_checkpoint(const SimulationStepper& simulation, const std::string& path, std::string& error,
+                     long long* bytes_written) {
+    std::vector<uint8_t> bytes(MAGIC, MAGIC + sizeof(MAGIC));
+    simulation.save_state(bytes);
+    uint64_t sum = checksum(bytes.data() + sizeof(MAGIC), bytes.size() - sizeof(MAGIC));
+    for (int byte = 0; byte < 8; byte++) {
+        bytes.push_back(static_cast<uint8_t>(sum >> (8 * byte)));
+    }
+
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        // The last bytes only reach the disk on close: check after it, or a failed
+        // flush would rename a truncated file over the previous checkpoint
+        file.close();
+        if (!file) {
+            std::remove(temporary.c_str());
+            error = "cannot write " + temporary;
+            return false;
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        error = "cannot replace " + path;
+        return false;
+    }
+    if (bytes_written) *bytes_written = static_cast<long long>(bytes.size());
+    return true;
+}
+
+bool load_checkpoint(const std::string& path, SimulationStepper& simulation, std::string& error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (bytes.size() < sizeof(MAGIC) + 8 || std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        error = path + " is not a simulation checkpoint";
+        return false;
+    }
+    size_t state_size = bytes.size() - sizeof(MAGIC) - 8;
+    const uint8_t* state = bytes.data() + sizeof(MAGIC);
+    uint64_t stored = 0;
+    for (int byte = 0; byte < 8; byte++) {
+        stored |= static_cast<uint64_t>(state[state_size + byte]) << (8 * byte);
+    }
+    if (stored != checksum(state, state_size)) {
+        error = path + " is damaged (checksum mismatch)";
+        return false;
+    }
+    if (!simulation.restore_state(state, state_size)) {
+        error = path + " holds an inconsistent simulation state";
+        return false;
+    }
+    return true;
+}
+
+bool run_with_checkpoints(SimulationStepper& simulation, const std::string& path, int interval,
+                          CheckpointStats& stats, std::string& error) {
+    interval = std::max(1, interval);
+    auto checkpoint = [&]() {
+        auto start = std::chrono::high_resolution_clock::now();
+        if (!save_checkpoint(simulation, path, error, &stats.last_bytes)) return false;
+        auto end = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        stats.checkpoints++;
+        stats.total_ms += ms;
+        stats.max_ms = std::max(stats.max_ms, ms);
+        return true;
+    };
+
+    while (simulation.advance()) {
+        if (simulation.steps() % interval == 0 && !simulation.done() && !checkpoint()) return false;
+    }
+    return checkpoint();
+}
@@ -0,0 +1,36 @@
+#ifndef SIMULATION_CHECKPOINT_H
+#define SIMULATION_CHECKPOINT_H
+
+#include <string>
+#include "simulation_stepper.h"
+
+struct CheckpointStats {
+    int checkpoints = 0;
+    long long last_bytes = 0;  // Size of the latest checkpoint
+    double total_ms = 0.0;     // Time spent encoding and writing them
+    double max_ms = 0.0;
+};
+
+// Checkpoint files for long simulations.
+//
+// Ants are interchangeable, so the state of every ant is the room it is in:
+// a checkpoint stores the room occupancy with the routes, capacities, remaining
+// quotas, move rule and step counter (see SimulationStepper::save_state), which
+// is all advance() reads. A resumed simulation plays bit-identical moves.
+//
+// The file is an 8-byte magic, the state, and a 64-bit FNV-1a checksum of the
+// state. It is written beside the target and renamed over it, so a process
+// killed while writing leaves the previous checkpoint intact. If given, bytes
+// receives the size of the file.
+bool save_checkpoint(const SimulationStepper& simulation, const std::string& path, std::string& error,
+                     long long* bytes = nullptr);
+
+// False, with the reason in error, if the file is missing, damaged or not a checkpoint
+bool load_checkpoint(const std::string& path, SimulationStepper& simulation, std::string& error);
+
+// Plays simulation to its end, saving it to path every `interval` steps and once
+// done. Returns false, with the reason in error, if a checkpoint cannot be written.
+bool run_with_checkpoints(SimulationStepper& simulation, const std::string& path, int interval,
+                          CheckpointStats& stats, std::string& error);
+
+#endif
@@ -0,0 +1,49 @@
+#include "simulation_scheduler.h"
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include "worker_team.h"
+
+size_t SimulationScheduler::add(SimulationStepper simulation) {
+    queued.push_back(std::move(simulation));
+    halted.push_back(0);
+    return queued.size() - 1;
+}
+
+void SimulationScheduler::run(int threads, int quantum, const StepObserver& observer) {
+    quantum = std::max(1, quantum);
+
+    std::deque<size_t> ready;
+    for (size_t id = 0; id < queued.size(); id++) {
+        if (!queued[id].done() && !halted[id]) ready.push_back(id);
+    }
+    std::mutex ready_lock;
+
+    // Workers leave once the queue is empty; simulations still held by the others
+    // are put back and picked up again by their own worker
+    WorkerTeam team(std::max(1, threads));
+    team.run([&](int) {
+        while (true) {
+            size_t id;
+            {
+                std::lock_guard<std::mutex> lock(ready_lock);
+                if (ready.empty()) return;
+                id = ready.front();
+                ready.pop_front();
+            }
+
+            SimulationStepper& simulation = queued[id];
+            for (int step = 0; step < quantum && simulation.advance(); step++) {
+                if (observer && !observer(id, simulation)) {
+                    halted[id] = 1;
+                    break;
+                }
+            }
+
+            if (!simulation.done() && !halted[id]) {
+                std::lock_guard<std::mutex> lock(ready_lock);
+                ready.push_back(id);
+            }
+        }
+    });
+}
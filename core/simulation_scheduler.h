@@ -0,0 +1,36 @@
+#ifndef SIMULATION_SCHEDULER_H
+#define SIMULATION_SCHEDULER_H
+
+#include <functional>
+#include <vector>
+#include "simulation_stepper.h"
+
+// Plays many simulations on a few threads, a few steps of one at a time.
+//
+// Simulations wait in a round-robin queue: a worker takes the next one, advances
+// it `quantum` steps, and puts it back unless it is done. Thousands of runs thus
+// progress together instead of one after the other, and a caller watching the
+// steps can stop any of them early. A simulation is only ever on one thread.
+class SimulationScheduler {
+public:
+    // Called after each step with the simulation's id; returning false stops that
+    // simulation where it is. Runs on the worker threads.
+    using StepObserver = std::function<bool(size_t id, const SimulationStepper& simulation)>;
+
+    // Returns the simulation's id: its index in simulations()
+    size_t add(SimulationStepper simulation);
+
+    // Plays every simulation until it is done or stopped, on `threads` threads
+    void run(int threads, int quantum = 16, const StepObserver& observer = nullptr);
+
+    const std::vector<SimulationStepper>& simulations() const { return queued; }
+
+    // Whether the observer stopped simulation id before it was done
+    bool stopped(size_t id) const { return halted[id]; }
+
+private:
+    std::vector<SimulationStepper> queued;
+    std::vector<char> halted;
+};
+
+#endif
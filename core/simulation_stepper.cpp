@@ -0,0 +1,153 @@
+#include "simulation_stepper.h"
+#include <algorithm>
+#include <climits>
+#include <utility>
+#include "varint.h"
+
+SimulationStepper::SimulationStepper(std::vector<std::vector<int>> routes, std::vector<int> capacities, int ants,
+                                     MoveRule rule, std::vector<int> quota)
+    : paths(std::move(routes)), quota(std::move(quota)), capacity(std::move(capacities)),
+      ants_per_room(capacity.size(), 0), rule(rule), total_ants(ants) {
+    if (!ants_per_room.empty()) ants_per_room[0] = total_ants;
+}
+
+bool SimulationStepper::done() const {
+    return paths.empty() || blocked || arrived() >= total_ants;
+}
+
+int SimulationStepper::send(int from, int to, int limit) {
+    int available = ants_per_room[from];
+    if (available <= 0) return 0;  // Most rooms of a long route are empty
+    int can_send = std::min(std::min(available, capacity[to] - ants_per_room[to]), limit);
+    if (can_send <= 0) return 0;
+    ants_per_room[from] -= can_send;
+    ants_per_room[to] += can_send;
+    last_moves.push_back({can_send, from, to});
+    return can_send;
+}
+
+bool SimulationStepper::advance() {
+    last_moves.clear();
+    if (done()) return false;
+
+    // Ants are moved in place: a room emptied earlier in the step can be refilled
+    // later in the same step, as the simulate_* loops have always done
+    for (size_t r = 0; r < paths.size(); ++r) {
+        const std::vector<int>& route = paths[r];
+        int last = static_cast<int>(route.size()) - 2;
+        if (rule == MoveRule::Single) {
+            for (int i = 0; i <= last; ++i) {
+                send(route[i], route[i + 1], 1);
+            }
+            continue;
+        }
+        for (int i = last; i >= 0; --i) {
+            if (i == 0 && !quota.empty()) {
+                // Leaving the start: only this route's share of the colony
+                quota[r] -= send(route[0], route[1], quota[r]);
+            } else {
+                send(route[i], route[i + 1], INT_MAX);
+            }
+        }
+    }
+
+    if (last_moves.empty()) {
+        blocked = true;
+    } else {
+        played++;
+    }
+    return true;
+}
+
+int SimulationStepper::result() const {
+    return !paths.empty() && arrived() >= total_ants ? played : -1;
+}
+
+void SimulationStepper::save_state(std::vector<uint8_t>& out) const {
+    put_varint(out, static_cast<uint64_t>(rule));
+    put_varint(out, total_ants);
+    put_varint(out, played);
+    put_varint(out, blocked ? 1 : 0);
+
+    put_varint(out, capacity.size());
+    for (int room_capacity : capacity) put_zigzag(out, room_capacity);
+    for (int ants : ants_per_room) put_varint(out, ants);
+
+    // Consecutive rooms of a route are usually close: store the differences
+    put_varint(out, paths.size());
+    for (const std::vector<int>& route : paths) {
+        put_varint(out, route.size());
+        int previous = 0;
+        for (int room : route) {
+            put_zigzag(out, room - previous);
+            previous = room;
+        }
+    }
+    put_varint(out, quota.size());
+    for (int left : quota) put_zigzag(out, left);
+}
+
+bool SimulationStepper::restore_state(const uint8_t* data, size_t size) {
+    size_t position = 0;
+    uint64_t value;
+    int64_t signed_value;
+    auto read = [&](uint64_t limit) {
+        return get_varint(data, size, position, value) && value <= limit;
+    };
+    auto read_signed = [&]() {
+        return get_zigzag(data, size, position, signed_value) && signed_value >= INT_MIN && signed_value <= INT_MAX;
+    };
+
+    SimulationStepper state;
+    if (!read(static_cast<uint64_t>(MoveRule::Single))) return false;
+    state.rule = static_cast<MoveRule>(value);
+    if (!read(INT_MAX)) return false;
+    state.total_ants = static_cast<int>(value);
+    if (!read(INT_MAX)) return false;
+    state.played = static_cast<int>(value);
+    if (!read(1)) return false;
+    state.blocked = value == 1;
+
+    // Every count is checked against the bytes left before anything is allocated
+    if (!read(size - position)) return false;
+    size_t rooms = value;
+    state.capacity.resize(rooms);
+    state.ants_per_room.resize(rooms);
+    for (int& room_capacity : state.capacity) {
+        if (!read_signed()) return false;
+        room_capacity = static_cast<int>(signed_value);
+    }
+    long long ants = 0;
+    for (int& room_ants : state.ants_per_room) {
+        if (!read(INT_MAX)) return false;
+        room_ants = static_cast<int>(value);
+        ants += room_ants;
+    }
+    if (ants != state.total_ants) return false;
+
+    if (!read(size - position)) return false;
+    state.paths.resize(value);
+    for (std::vector<int>& route : state.paths) {
+        if (!read(size - position) || value < 2) return false;
+        route.resize(value);
+        int64_t room = 0;
+        for (int& step : route) {
+            if (!get_zigzag(data, size, position, signed_value)) return false;
+            if (signed_value <= -static_cast<int64_t>(rooms) || signed_value >= static_cast<int64_t>(rooms)) return false;
+            room += signed_value;
+            if (room < 0 || room >= static_cast<int64_t>(rooms)) return false;
+            step = static_cast<int>(room);
+        }
+    }
+    if (!read(size - position)) return false;
+    if (value != 0 && value != state.paths.size()) return false;
+    state.quota.resize(value);
+    for (int& left : state.quota) {
+        if (!read_signed()) return false;
+        left = static_cast<int>(signed_value);
+    }
+    if (position != size) return false;
+
+    *this = std::move(state);
+    return true;
+}
@@ -0,0 +1,83 @@
+#ifndef SIMULATION_STEPPER_H
+#define SIMULATION_STEPPER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct AntMove {
+    int ants;
+    int from;
+    int to;
+};
+
+// How ants advance along the routes in one step
+enum class MoveRule {
+    Flow,    // Each route from its last tunnel back to the start, as many ants as fit
+    Single,  // Each route from the start forward, at most one ant per tunnel (A*)
+};
+
+// Resumable ant simulation: the step loop of the simulate_* functions, one step
+// per advance() call.
+//
+// The caller pulls steps when it wants them, can run many simulations side by
+// side and drop one at any point; only the current step's moves are kept.
+// Self-contained: it copies the routes and capacities, so it outlives the
+// anthill that built it.
+class SimulationStepper {
+    std::vector<std::vector<int>> paths;
+    std::vector<int> quota;        // Ants each route may still take from the start, if limited
+    std::vector<int> capacity;
+    std::vector<int> ants_per_room;
+    std::vector<AntMove> last_moves;
+    MoveRule rule = MoveRule::Flow;
+    int total_ants = 0;
+    int played = 0;
+    bool blocked = false;
+
+    // Moves as many ants as fit, up to limit, from one room to the next; returns how many
+    int send(int from, int to, int limit);
+
+public:
+    // A simulation with no route: done at once, result -1
+    SimulationStepper() = default;
+
+    // routes run from room 0 to the dormitory (the last room). quota, if not empty,
+    // caps how many ants each route takes from the start over the whole run.
+    SimulationStepper(std::vector<std::vector<int>> routes, std::vector<int> capacities, int ants,
+                      MoveRule rule = MoveRule::Flow, std::vector<int> quota = {});
+
+    // Every ant reached the dormitory, the ants are stuck, or there was no route
+    bool done() const;
+
+    // Plays one step. A step that moves nothing marks the ants stuck. Returns false,
+    // doing nothing, once done().
+    bool advance();
+
+    // Moves of the step advance() just played, in the order the simulation made them
+    const std::vector<AntMove>& moves() const { return last_moves; }
+    const std::vector<int>& occupancy() const { return ants_per_room; }
+    const std::vector<int>& capacities() const { return capacity; }
+    const std::vector<std::vector<int>>& routes() const { return paths; }
+
+    int ants() const { return total_ants; }
+    int rooms() const { return static_cast<int>(capacity.size()); }
+    int arrived() const { return ants_per_room.empty() ? 0 : ants_per_room.back(); }
+
+    // Steps that moved ants so far
+    int steps() const { return played; }
+    bool stuck() const { return blocked; }
+
+    // What simulate_* returns: the number of steps once every ant arrived, else -1
+    int result() const;
+
+    // Appends everything advance() depends on to out, as varints: restoring it
+    // gives a stepper that plays exactly the same moves from here
+    void save_state(std::vector<uint8_t>& out) const;
+
+    // Reads back save_state(). False, leaving this stepper unchanged, if the data
+    // is truncated or inconsistent (a room out of range, ants lost or created).
+    bool restore_state(const uint8_t* data, size_t size);
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Bounded lock-free queue between exactly one producer thread and one consumer thread.
+//
+// The producer only writes `tail` and the consumer only writes `head`; each side
+// keeps a cached copy of the other's index and rereads it only when the ring looks
+// full (or empty), so the common case touches no shared cache line. Capacity is
+// rounded up to a power of two.
+template <typename T>
+class SpscRing {
+    static constexpr size_t CACHE_LINE = 64;
+
+    std::vector<T> slots;
+    size_t mask;
+
+    alignas(CACHE_LINE) std::atomic<size_t> head{0};  // Next slot to pop, written by the consumer
+    size_t cached_tail = 0;                            // Consumer's view of tail
+
+    alignas(CACHE_LINE) std::atomic<size_t> tail{0};  // Next slot to push, written by the producer
+    size_t cached_head = 0;                            // Producer's view of head
+
+public:
+    explicit SpscRing(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size *= 2;
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    // Producer side. Returns false, leaving the ring unchanged, if it is full.
+    bool try_push(const T& value) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        if (position - cached_head == slots.size()) {
+            cached_head = head.load(std::memory_order_acquire);
+            if (position - cached_head == slots.size()) return false;
+        }
+        slots[position & mask] = value;
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Moves up to `max` values into out and returns how many.
+    size_t pop_batch(T* out, size_t max) {
+        size_t position = head.load(std::memory_order_relaxed);
+        if (cached_tail == position) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (cached_tail == position) return 0;
+        }
+        size_t count = std::min(max, cached_tail - position);
+        for (size_t i = 0; i < count; i++) {
+            out[i] = slots[(position + i) & mask];
+        }
+        head.store(position + count, std::memory_order_release);
+        return count;
+    }
+
+    size_t capacity() const { return slots.size(); }
+};
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef TRACE_FORMAT_H
+#define TRACE_FORMAT_H
+
+#include <cstdint>
+#include "varint.h"
+
+// On-disk layout shared by TraceLog (writer) and TraceReplay (reader).
+//
+// After the magic, a trace is a sequence of records, each a tag byte followed by
+// unsigned LEB128 varints ("v") and zigzag-encoded signed varints ("z"):
+//
+//   'R' run       v rooms, v ants, rooms x v capacity
+//   'K' snapshot  v step, v rooms holding ants, then per such room (in order)
+//                 v room - previous room, v ants        (occupancy before the step)
+//   'S' step      v step, v moves, then per move
+//                 v ants, z from - previous from, z to - from
+//   'X' stuck     v step
+//   'F' finish    z steps, or -1
+//
+// A file may hold several runs, each starting with 'R'. Snapshots are written
+// every few steps so a reader can seek without replaying from the start.
+namespace trace_format {
+    const char MAGIC[8] = {'A', 'N', 'T', 'T', 'R', 'C', '2', '\n'};
+
+    enum Tag : uint8_t { RUN = 'R', SNAPSHOT = 'K', STEP = 'S', STUCK = 'X', FINISH = 'F' };
+}
+
+#endif
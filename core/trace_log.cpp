@@ -0,0 +1,149 @@
+#include "trace_log.h"
+#include <algorithm>
+#include <chrono>
+#include "trace_format.h"
+
+using namespace trace_format;
+
+TraceLog::TraceLog(const std::string& path, int snapshot_interval, size_t capacity)
+    : ring(capacity), file(std::fopen(path.c_str(), "wb")) {
+    encoder.snapshot_interval = std::max(1, snapshot_interval);
+    if (!file) return;
+    std::fwrite(MAGIC, 1, sizeof(MAGIC), file);
+    written = sizeof(MAGIC);
+    writer = std::thread([this] { drain(); });
+}
+
+TraceLog::~TraceLog() {
+    close();
+}
+
+void TraceLog::close() {
+    if (!file) return;
+    stopping.store(true, std::memory_order_release);
+    writer.join();
+    std::fclose(file);
+    file = nullptr;
+}
+
+void TraceLog::start_run(const std::vector<int>& capacities, int ants) {
+    record(TraceEvent::start(static_cast<int>(capacities.size()), ants));
+    for (size_t room = 0; room < capacities.size(); room++) {
+        record(TraceEvent::room(static_cast<int>(room), capacities[room]));
+    }
+}
+
+void TraceLog::wait_and_push(const TraceEvent& event) {
+    if (!file) return;
+    full_waits++;
+    while (!ring.try_push(event)) {
+        std::this_thread::yield();
+    }
+}
+
+void TraceLog::drain() {
+    std::vector<TraceEvent> batch(4096);
+    while (true) {
+        // Read before popping: once stopping is seen, an empty pop means every event is out
+        bool last = stopping.load(std::memory_order_acquire);
+        size_t count = ring.pop_batch(batch.data(), batch.size());
+        for (size_t i = 0; i < count; i++) {
+            encode(batch[i]);
+        }
+        if (encoder.buffer.size() >= (1 << 16)) flush_buffer();
+        if (count > 0) continue;
+
+        if (last) {
+            end_step();
+            flush_buffer();
+            break;
+        }
+        flush_buffer();
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+}
+
+void TraceLog::encode(const TraceEvent& event) {
+    std::vector<uint8_t>& out = encoder.buffer;
+    switch (event.kind) {
+    case TraceEvent::START:
+        end_step();
+        encoder.ants = event.b;
+        encoder.capacities.assign(std::max(0, event.a), 0);
+        encoder.occupancy.assign(encoder.capacities.size(), 0);
+        if (!encoder.occupancy.empty()) encoder.occupancy[0] = event.b;
+        encoder.rooms_missing = event.a;
+        break;
+    case TraceEvent::ROOM:
+        if (event.a < 0 || event.a >= static_cast<int>(encoder.capacities.size())) break;
+        encoder.capacities[event.a] = event.b;
+        if (--encoder.rooms_missing == 0) {
+            out.push_back(RUN);
+            put_varint(out, encoder.capacities.size());
+            put_varint(out, encoder.ants);
+            for (int capacity : encoder.capacities) put_varint(out, capacity);
+        }
+        break;
+    case TraceEvent::STEP:
+        end_step();
+        encoder.step = event.a;
+        if (event.a > 0 && event.a % encoder.snapshot_interval == 0) {
+            int holding = static_cast<int>(std::count_if(encoder.occupancy.begin(), encoder.occupancy.end(),
+                                                         [](int ants) { return ants != 0; }));
+            out.push_back(SNAPSHOT);
+            put_varint(out, event.a);
+            put_varint(out, holding);
+            size_t previous = 0;
+            for (size_t room = 0; room < encoder.occupancy.size(); room++) {
+                if (encoder.occupancy[room] == 0) continue;
+                put_varint(out, room - previous);
+                put_varint(out, encoder.occupancy[room]);
+                previous = room;
+            }
+        }
+        break;
+    case TraceEvent::MOVE:
+        encoder.moves.push_back(event);
+        if (event.b >= 0 && event.c >= 0 && event.b < static_cast<int>(encoder.occupancy.size()) &&
+            event.c < static_cast<int>(encoder.occupancy.size())) {
+            encoder.occupancy[event.b] -= event.a;
+            encoder.occupancy[event.c] += event.a;
+        }
+        break;
+    case TraceEvent::STUCK:
+        end_step();
+        out.push_back(STUCK);
+        put_varint(out, event.a);
+        break;
+    case TraceEvent::FINISH:
+        end_step();
+        out.push_back(FINISH);
+        put_zigzag(out, event.a);
+        break;
+    }
+}
+
+// Writes the pending step: its moves are only known once the next event arrives
+void TraceLog::end_step() {
+    if (encoder.step < 0) return;
+    std::vector<uint8_t>& out = encoder.buffer;
+    out.push_back(STEP);
+    put_varint(out, encoder.step);
+    put_varint(out, encoder.moves.size());
+    int64_t previous_from = 0;
+    for (const TraceEvent& move : encoder.moves) {
+        put_varint(out, move.a);
+        put_zigzag(out, static_cast<int64_t>(move.b) - previous_from);
+        put_zigzag(out, static_cast<int64_t>(move.c) - move.b);
+        previous_from = move.b;
+    }
+    encoder.moves.clear();
+    encoder.step = -1;
+}
+
+void TraceLog::flush_buffer() {
+    if (encoder.buffer.empty()) return;
+    std::fwrite(encoder.buffer.data(), 1, encoder.buffer.size(), file);
+    written.fetch_add(static_cast<long long>(encoder.buffer.size()), std::memory_order_relaxed);
+    encoder.buffer.clear();
+}
@@ -0,0 +1,91 @@
+#ifndef TRACE_LOG_H
+#define TRACE_LOG_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include "spsc_ring.h"
+
+// One simulation event as the solvers record it: 16 bytes, encoded by the writer thread
+struct TraceEvent {
+    enum Kind : int32_t { START, ROOM, STEP, MOVE, STUCK, FINISH };
+
+    Kind kind;
+    int32_t a, b, c;  // START: rooms, ants; ROOM: room, capacity; STEP: step; MOVE: ants, from, to;
+                      // STUCK: step; FINISH: steps or -1
+
+    static TraceEvent start(int rooms, int ants) { return {START, rooms, ants, 0}; }
+    static TraceEvent room(int room, int capacity) { return {ROOM, room, capacity, 0}; }
+    static TraceEvent step(int step) { return {STEP, step, 0, 0}; }
+    static TraceEvent move(int ants, int from, int to) { return {MOVE, ants, from, to}; }
+    static TraceEvent stuck(int step) { return {STUCK, step, 0, 0}; }
+    static TraceEvent finish(int steps) { return {FINISH, steps, 0, 0}; }
+};
+
+// Binary simulation trace written by a background thread.
+//
+// The solver thread only copies events into a lock-free ring; a writer thread
+// drains it, delta-encodes each step's moves as varints (see trace_format.h) and
+// writes a full snapshot of the room occupancy every `snapshot_interval` steps.
+// record() never drops an event: when the ring is full it yields until the
+// writer catches up, and counts a stall. One thread at a time may record into a log.
+//
+// TraceReplay reads the file back.
+class TraceLog {
+public:
+    explicit TraceLog(const std::string& path, int snapshot_interval = 64, size_t capacity = 1 << 16);
+    ~TraceLog();
+
+    TraceLog(const TraceLog&) = delete;
+    TraceLog& operator=(const TraceLog&) = delete;
+
+    bool is_open() const { return file != nullptr; }
+
+    void record(const TraceEvent& event) {
+        recorded++;
+        if (!ring.try_push(event)) wait_and_push(event);
+    }
+
+    // Starts a run: the room count, the colony and every room's capacity
+    void start_run(const std::vector<int>& capacities, int ants);
+
+    // Writes every recorded event and stops the writer thread. Called by the destructor.
+    void close();
+
+    long long events() const { return recorded; }
+    long long stalls() const { return full_waits; }
+    long long bytes_written() const { return written.load(std::memory_order_relaxed); }
+
+private:
+    // Writer-thread state of the run being encoded
+    struct Encoder {
+        int snapshot_interval;
+        std::vector<int> capacities;
+        std::vector<int> occupancy;
+        int ants = 0;
+        int rooms_missing = 0;  // ROOM events still expected before the run record
+        int step = -1;          // Step whose moves are pending, or -1
+        std::vector<TraceEvent> moves;
+        std::vector<uint8_t> buffer;
+    };
+
+    SpscRing<TraceEvent> ring;
+    std::FILE* file;
+    std::thread writer;
+    std::atomic<bool> stopping{false};
+    std::atomic<long long> written{0};
+    long long recorded = 0;
+    long long full_waits = 0;
+    Encoder encoder;
+
+    void wait_and_push(const TraceEvent& event);
+    void drain();
+    void encode(const TraceEvent& event);
+    void end_step();
+    void flush_buffer();
+};
+
+#endif
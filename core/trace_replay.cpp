@@ -0,0 +1,228 @@
+#include "trace_replay.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <thread>
+#include "trace_format.h"
+
+using namespace trace_format;
+
+namespace {
+    // Decodes one step record (after its tag) into moves. False if truncated or
+    // if a move leaves the hill's `rooms` rooms.
+    bool read_step(const std::vector<uint8_t>& data, size_t& position, int rooms, uint64_t& step,
+                   std::vector<TraceMove>* moves) {
+        uint64_t count;
+        if (!get_varint(data.data(), data.size(), position, step) ||
+            !get_varint(data.data(), data.size(), position, count)) {
+            return false;
+        }
+        int64_t from = 0;
+        for (uint64_t i = 0; i < count; i++) {
+            uint64_t ants;
+            int64_t from_delta, to_delta;
+            if (!get_varint(data.data(), data.size(), position, ants) ||
+                !get_zigzag(data.data(), data.size(), position, from_delta) ||
+                !get_zigzag(data.data(), data.size(), position, to_delta)) {
+                return false;
+            }
+            from += from_delta;
+            if (from < 0 || from >= rooms || from + to_delta < 0 || from + to_delta >= rooms) return false;
+            if (moves) {
+                moves->push_back({static_cast<int>(ants), static_cast<int>(from), static_cast<int>(from + to_delta)});
+            }
+        }
+        return true;
+    }
+
+    bool read_snapshot(const std::vector<uint8_t>& data, size_t& position, uint64_t& step, std::vector<int>* rooms) {
+        uint64_t holding;
+        if (!get_varint(data.data(), data.size(), position, step) ||
+            !get_varint(data.data(), data.size(), position, holding)) {
+            return false;
+        }
+        uint64_t room = 0;
+        for (uint64_t i = 0; i < holding; i++) {
+            uint64_t delta, ants;
+            if (!get_varint(data.data(), data.size(), position, delta) ||
+                !get_varint(data.data(), data.size(), position, ants)) {
+                return false;
+            }
+            room += delta;
+            if (rooms && room < rooms->size()) (*rooms)[room] = static_cast<int>(ants);
+        }
+        return true;
+    }
+}
+
+bool TraceReplay::open(const std::string& path, std::string& error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    recorded.clear();
+
+    if (data.size() < sizeof(MAGIC) || std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        error = path + " is not a simulation trace";
+        return false;
+    }
+
+    // Index the records; a truncated one ends the trace
+    size_t position = sizeof(MAGIC);
+    while (position < data.size()) {
+        size_t record = position;
+        uint8_t tag = data[position++];
+        uint64_t value;
+        int64_t signed_value;
+
+        if (tag == RUN) {
+            uint64_t rooms, ants;
+            if (!get_varint(data.data(), data.size(), position, rooms) ||
+                !get_varint(data.data(), data.size(), position, ants)) {
+                break;
+            }
+            Run run;
+            run.ants = static_cast<int>(ants);
+            bool complete = true;
+            for (uint64_t room = 0; room < rooms && complete; room++) {
+                complete = get_varint(data.data(), data.size(), position, value);
+                run.capacities.push_back(static_cast<int>(value));
+            }
+            if (!complete) break;
+            recorded.push_back(std::move(run));
+            continue;
+        }
+
+        if (recorded.empty()) {
+            error = path + ": record outside a run";
+            return false;
+        }
+        Run& run = recorded.back();
+
+        if (tag == STEP) {
+            if (!read_step(data, position, run.rooms(), value, nullptr)) break;
+            run.step_records.push_back(record);
+        } else if (tag == SNAPSHOT) {
+            if (!read_snapshot(data, position, value, nullptr)) break;
+            run.snapshots.emplace_back(static_cast<int>(value), record);
+        } else if (tag == STUCK) {
+            if (!get_varint(data.data(), data.size(), position, value)) break;
+            run.stuck = true;
+        } else if (tag == FINISH) {
+            if (!get_zigzag(data.data(), data.size(), position, signed_value)) break;
+            run.finished = true;
+            run.result = static_cast<int>(signed_value);
+        } else {
+            error = path + ": unknown record";
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<TraceMove> TraceReplay::moves(size_t run, int step) const {
+    std::vector<TraceMove> result;
+    const Run& r = recorded[run];
+    if (step < 0 || step >= r.steps()) return result;
+
+    size_t position = r.step_records[step] + 1;
+    uint64_t index;
+    read_step(data, position, r.rooms(), index, &result);
+    return result;
+}
+
+void TraceReplay::apply(size_t run, int step, std::vector<int>& rooms) const {
+    for (const TraceMove& move : moves(run, step)) {
+        rooms[move.from] -= move.ants;
+        rooms[move.to] += move.ants;
+    }
+}
+
+std::vector<int> TraceReplay::occupancy(size_t run, int step) const {
+    const Run& r = recorded[run];
+    step = std::clamp(step, 0, r.steps());
+
+    std::vector<int> rooms(r.rooms(), 0);
+    int base = 0;
+    auto after = std::upper_bound(r.snapshots.begin(), r.snapshots.end(), step,
+                                  [](int s, const std::pair<int, size_t>& snapshot) { return s < snapshot.first; });
+    if (after != r.snapshots.begin()) {
+        auto snapshot = std::prev(after);
+        size_t position = snapshot->second + 1;
+        uint64_t index;
+        read_snapshot(data, position, index, &rooms);
+        base = snapshot->first;
+    } else if (!rooms.empty()) {
+        rooms[0] = r.ants;
+    }
+
+    for (int s = base; s < step; s++) {
+        apply(run, s, rooms);
+    }
+    return rooms;
+}
+
+void TraceReplay::render(size_t run, int first, int last, std::ostream& out, int delay_ms) const {
+    const Run& r = recorded[run];
+    int end_room = r.rooms() - 1;
+    first = std::clamp(first, 0, r.steps());
+    last = std::min(last, r.steps() - 1);
+    if (end_room < 0) return;
+
+    if (first == 0) {
+        out << "\n" << std::string(60, '=') << "\n";
+        out << "  🐜 SIMULATION REPLAY - RUN " << run << "\n";
+        out << "  Rooms: " << r.rooms() << " | Ants: " << r.ants << "\n";
+        out << std::string(60, '=') << "\n\n";
+    }
+
+    std::vector<int> rooms = occupancy(run, first);
+    for (int step = first; step <= last; step++) {
+        out << "\n⏱️  STEP " << step << "\n";
+        out << std::string(30, '-') << "\n";
+        for (const TraceMove& move : moves(run, step)) {
+            out << "  🐜 " << move.ants << " ant(s) moved from Room "
+                << move.from << " to Room " << move.to << "\n";
+            rooms[move.from] -= move.ants;
+            rooms[move.to] += move.ants;
+        }
+
+        out << "\n  ROOM STATUS (" << rooms[end_room] << "/" << r.ants << " ants in dormitory):\n";
+        for (int i = 0; i < r.rooms(); ++i) {
+            std::string room_type = (i == 0) ? "START" :
+                                   (i == end_room) ? "DORMITORY" : "ROOM";
+            out << "  • " << room_type << " " << i << ": "
+                << rooms[i] << "/" << r.capacities[i] << " ants";
+            if (i == end_room && rooms[i] > 0) {
+                out << " 🏠";
+            }
+            out << "\n";
+        }
+
+        if (delay_ms > 0 && step < last) {
+            out.flush();
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+        }
+    }
+
+    if (last != r.steps() - 1) return;
+    if (r.stuck) {
+        out << "\n⚠️  No movement possible - ants are stuck! Check room capacities.\n";
+    }
+    if (r.finished) {
+        out << "\n" << std::string(60, '=') << "\n";
+        if (r.result >= 0) {
+            out << "  🎉 SIMULATION COMPLETE! 🎉" << "\n";
+            out << "  All " << r.ants << " ants reached the dormitory" << "\n";
+        } else {
+            out << "  ❌ " << rooms[end_room] << "/" << r.ants << " ants reached the dormitory" << "\n";
+        }
+        out << "  Total steps: " << r.steps() - (r.stuck ? 1 : 0) << "\n";
+        out << std::string(60, '=') << "\n\n";
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef TRACE_REPLAY_H
+#define TRACE_REPLAY_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct TraceMove {
+    int ants;
+    int from;
+    int to;
+};
+
+// Reads back a TraceLog file and renders or seeks through its runs without
+// running any solver.
+//
+// open() loads the file and indexes every step and snapshot in one pass. The
+// occupancy at any step is rebuilt from the nearest snapshot at or before it,
+// so seeking replays at most one snapshot interval of moves. A file cut short
+// (say, by a crash) replays up to its last complete record.
+class TraceReplay {
+public:
+    struct Run {
+        int ants = 0;
+        std::vector<int> capacities;
+        bool stuck = false;
+        bool finished = false;
+        int result = -1;  // Steps as returned by the simulation, -1 if it failed
+
+        int rooms() const { return static_cast<int>(capacities.size()); }
+        int steps() const { return static_cast<int>(step_records.size()); }
+
+    private:
+        friend class TraceReplay;
+        std::vector<size_t> step_records;               // Offset of each step's record
+        std::vector<std::pair<int, size_t>> snapshots;  // (step, offset), by step
+    };
+
+    // False, with the reason in error, if the file is missing or not a trace
+    bool open(const std::string& path, std::string& error);
+
+    const std::vector<Run>& runs() const { return recorded; }
+
+    // Ants in each room before the moves of `step` (step == steps() gives the end state)
+    std::vector<int> occupancy(size_t run, int step) const;
+
+    std::vector<TraceMove> moves(size_t run, int step) const;
+
+    // Prints steps first..last of a run the way the verbose simulations do,
+    // pausing delay_ms between steps
+    void render(size_t run, int first, int last, std::ostream& out, int delay_ms = 0) const;
+
+private:
+    std::vector<uint8_t> data;
+    std::vector<Run> recorded;
+
+    void apply(size_t run, int step, std::vector<int>& rooms) const;
+};
+
+#endif
@@ -0,0 +1,85 @@
+#include "tunnel_set.h"
+#include <algorithm>
+
+uint64_t TunnelSet::key(int a, int b) {
+    if (a > b) std::swap(a, b);
+    return (static_cast<uint64_t>(a) << 32) | static_cast<uint32_t>(b);
+}
+
+size_t TunnelSet::home(uint64_t key) const {
+    // splitmix64 finalizer: consecutive rooms would otherwise fill consecutive slots
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return static_cast<size_t>(key) & (slots.size() - 1);
+}
+
+size_t TunnelSet::find_slot(uint64_t key) const {
+    const size_t mask = slots.size() - 1;
+    size_t slot = home(key);
+    while (slots[slot] != EMPTY && slots[slot] != key) slot = (slot + 1) & mask;
+    return slot;
+}
+
+void TunnelSet::rehash(size_t capacity) {
+    std::vector<uint64_t> old = std::move(slots);
+    slots.assign(capacity, EMPTY);
+    for (uint64_t entry : old) {
+        if (entry != EMPTY) slots[find_slot(entry)] = entry;
+    }
+}
+
+void TunnelSet::reserve(size_t tunnels) {
+    size_t capacity = std::max<size_t>(16, slots.size());
+    while (capacity < 2 * tunnels) capacity *= 2;
+    if (capacity != slots.size()) rehash(capacity);
+}
+
+bool TunnelSet::insert(int a, int b) {
+    if (2 * (count + 1) > slots.size()) reserve(count + 1);
+    uint64_t entry = key(a, b);
+    size_t slot = find_slot(entry);
+    if (slots[slot] == entry) return false;
+    slots[slot] = entry;
+    count++;
+    return true;
+}
+
+bool TunnelSet::contains(int a, int b) const {
+    if (slots.empty()) return false;
+    uint64_t entry = key(a, b);
+    return slots[find_slot(entry)] == entry;
+}
+
+bool TunnelSet::erase(int a, int b) {
+    if (slots.empty()) return false;
+    size_t hole = find_slot(key(a, b));
+    if (slots[hole] == EMPTY) return false;
+
+    // Pull back every later entry of the run that may sit at or before the hole
+    const size_t mask = slots.size() - 1;
+    for (size_t next = (hole + 1) & mask; slots[next] != EMPTY; next = (next + 1) & mask) {
+        size_t wanted = home(slots[next]);
+        bool stays = hole <= next ? hole < wanted && wanted <= next : hole < wanted || wanted <= next;
+        if (!stays) {
+            slots[hole] = slots[next];
+            hole = next;
+        }
+    }
+    slots[hole] = EMPTY;
+    count--;
+    return true;
+}
+
+void reserve_tunnel_lists(std::vector<std::vector<int>>& graph, const std::vector<std::pair<int, int>>& tunnels) {
+    std::vector<size_t> added(graph.size(), 0);
+    for (const auto& [a, b] : tunnels) {
+        added[a]++;
+        added[b]++;
+    }
+    for (size_t room = 0; room < graph.size(); room++) {
+        if (added[room] > 0) graph[room].reserve(graph[room].size() + added[room]);
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef TUNNEL_SET_H
+#define TUNNEL_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// The tunnels of a hill as a hash set of room pairs, so that has_tunnel and the
+// duplicate check in add_tunnels take O(1) instead of a scan of the adjacency list.
+//
+// Open addressing with linear probing over a single array of 64-bit keys (smaller
+// room in the high half, so a-b and b-a are the same tunnel), kept at most half
+// full: about 16 bytes per tunnel and no allocation per entry. erase() shifts the
+// rest of the probe run back instead of leaving tombstones, so lookups stay short
+// on hills whose tunnels keep collapsing.
+class TunnelSet {
+public:
+    // Makes room for `tunnels` tunnels in total without rehashing
+    void reserve(size_t tunnels);
+
+    // False if a and b were already joined
+    bool insert(int a, int b);
+    // False if there was no a-b tunnel
+    bool erase(int a, int b);
+    bool contains(int a, int b) const;
+
+    size_t size() const { return count; }
+    size_t memory_bytes() const { return slots.capacity() * sizeof(uint64_t); }
+
+private:
+    static constexpr uint64_t EMPTY = ~uint64_t{0};
+
+    std::vector<uint64_t> slots;  // Power-of-two size, or empty
+    size_t count = 0;
+
+    static uint64_t key(int a, int b);
+    size_t home(uint64_t key) const;
+    size_t find_slot(uint64_t key) const;  // Slot holding key, or the empty slot ending its run
+    void rehash(size_t capacity);
+};
+
+// Grows every adjacency list of graph by its rooms' share of `tunnels` at once,
+// before a bulk add_tunnels appends them one by one
+void reserve_tunnel_lists(std::vector<std::vector<int>>& graph, const std::vector<std::pair<int, int>>& tunnels);
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef VARINT_H
+#define VARINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// LEB128 varints: 7 bits per byte, low bits first. Zigzag maps small signed
+// values to small unsigned ones (0, -1, 1, -2 ... -> 0, 1, 2, 3 ...).
+
+inline void put_varint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+inline void put_zigzag(std::vector<uint8_t>& out, int64_t value) {
+    put_varint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+// Reads a varint at data[position], advancing position. False if it runs past size.
+inline bool get_varint(const uint8_t* data, size_t size, size_t& position, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && position < size; shift += 7) {
+        uint8_t byte = data[position++];
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+inline bool get_zigzag(const uint8_t* data, size_t size, size_t& position, int64_t& value) {
+    uint64_t raw;
+    if (!get_varint(data, size, position, raw)) return false;
+    value = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+    return true;
+}
+
+#endif
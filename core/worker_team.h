@@ -0,0 +1,99 @@
+#ifndef WORKER_TEAM_H
+#define WORKER_TEAM_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Threads kept alive across the many short parallel phases of one search.
+// The calling thread takes part as thread 0.
+class WorkerTeam {
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable start_signal;
+    std::condition_variable done_signal;
+    const std::function<void(int)>* task = nullptr;
+    unsigned generation = 0;
+    int running = 0;
+    bool stopping = false;
+
+    void work(int thread) {
+        unsigned seen = 0;
+        while (true) {
+            const std::function<void(int)>* job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                start_signal.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                job = task;
+            }
+            (*job)(thread);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--running == 0) done_signal.notify_one();
+            }
+        }
+    }
+
+public:
+    explicit WorkerTeam(int threads) {
+        for (int thread = 1; thread < threads; ++thread) {
+            workers.emplace_back([this, thread] { work(thread); });
+        }
+    }
+
+    ~WorkerTeam() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        start_signal.notify_all();
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+
+    // Runs job(thread) on every thread and waits for all of them
+    void run(const std::function<void(int)>& job) {
+        if (workers.empty()) {
+            job(0);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            task = &job;
+            running = static_cast<int>(workers.size());
+            ++generation;
+        }
+        start_signal.notify_all();
+        job(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done_signal.wait(lock, [&] { return running == 0; });
+    }
+};
+
+// Hands out [begin, end) chunks of `chunk` items of a work list to whichever
+// thread asks first
+class ChunkCounter {
+    std::atomic<size_t> next{0};
+    size_t total;
+    size_t chunk;
+
+public:
+    explicit ChunkCounter(size_t total, size_t chunk = 256) : total(total), chunk(chunk) {}
+
+    bool take(size_t& begin, size_t& end) {
+        begin = next.fetch_add(chunk, std::memory_order_relaxed);
+        if (begin >= total) return false;
+        end = std::min(total, begin + chunk);
+        return true;
+    }
+};
+
+#endif
@@ -1,30 +1,72 @@
 #include "ants_dijkstra.h"
+#include "disjoint_routes.h"
 #include <iomanip>
 
 AnthillDijkstra::AnthillDijkstra(int total_rooms, int total_ants) 
-    : total_rooms(total_rooms), total_ants(total_ants) {
+    : total_rooms(total_rooms), total_ants(total_ants), connected_rooms(total_rooms) {
     graph.resize(total_rooms);
     room_capacity.resize(total_rooms, 0);
 }
 
-void AnthillDijkstra::add_tunnels(int a, int b) {
+bool AnthillDijkstra::add_tunnels(int a, int b) {
+    if (a == b || !tunnels.insert(a, b)) return false;
     graph[a].push_back(b);
     graph[b].push_back(a);
+    if (!connectivity_stale) connected_rooms.connect(a, b);
+    if (planner) planner->tunnel_changed(graph, a, b);
+    return true;
+}
+
+void AnthillDijkstra::add_tunnels(const std::vector<std::pair<int, int>>& tunnel_list) {
+    reserve_tunnel_lists(graph, tunnel_list);
+    tunnels.reserve(tunnels.size() + tunnel_list.size());
+    for (const auto& [a, b] : tunnel_list) add_tunnels(a, b);
+}
+
+bool AnthillDijkstra::remove_tunnel(int a, int b) {
+    if (!tunnels.erase(a, b)) return false;
+    graph[a].erase(std::find(graph[a].begin(), graph[a].end(), b));
+    graph[b].erase(std::find(graph[b].begin(), graph[b].end(), a));
+    connectivity_stale = true;
+    if (planner) planner->tunnel_changed(graph, a, b);
+    return true;
 }
 
 void AnthillDijkstra::set_room_capacity(int room, int c) {
     room_capacity[room] = c;
+    // The capacity penalty only depends on the room entered, not on the tunnel taken
+    if (planner) planner->set_entry_weight(graph, room, calculate_weight(room, room));
 }
 
 bool AnthillDijkstra::is_full(int ants, int c) {
     return ants >= c;
 }
 
-bool AnthillDijkstra::has_tunnel(int a, int b) {
-    return std::find(graph[a].begin(), graph[a].end(), b) != graph[a].end();
+bool AnthillDijkstra::has_tunnel(int a, int b) const {
+    return tunnels.contains(a, b);
+}
+
+bool AnthillDijkstra::dormitory_reachable() {
+    if (connectivity_stale) {
+        connected_rooms.rebuild(graph);
+        connectivity_stale = false;
+    }
+    return total_rooms > 0 && connected_rooms.connected(0, total_rooms - 1);
+}
+
+void AnthillDijkstra::set_verbose(bool v) {
+    verbose = v;
+}
+
+void AnthillDijkstra::set_trace(TraceLog* t) {
+    trace = t;
 }
 
-int AnthillDijkstra::calculate_weight(int from [[maybe_unused]], int to) {
+std::ostream& AnthillDijkstra::out() {
+    return verbose ? static_cast<std::ostream&>(std::cout) : quiet;
+}
+
+int AnthillDijkstra::calculate_weight(int from [[maybe_unused]], int to) const {
     int base_weight = 1;
     
     // Penalty for low capacity rooms
@@ -36,162 +78,382 @@ int AnthillDijkstra::calculate_weight(int from [[maybe_unused]], int to) {
     return base_weight;
 }
 
-void AnthillDijkstra::simulate_dijkstra() {
-    std::cout << "\n" << std::string(60, '=') << "\n";
-    std::cout << "  🐜 DIJKSTRA ALGORITHM SIMULATION - STARTING" << "\n";
-    std::cout << "  Rooms: " << total_rooms << " | Ants: " << total_ants << "\n";
-    std::cout << std::string(60, '=') << "\n\n";
+int AnthillDijkstra::find_best_path(DijkstraWorkspace& workspace, std::vector<int>& path, long long* expanded) {
+    if (!dormitory_reachable()) {
+        path.clear();
+        if (expanded) *expanded = 0;
+        return -1;
+    }
+    auto weight = [this](int from, int to) { return calculate_weight(from, to); };
+    return best_first_search(AdjacencyList(graph), 0, total_rooms - 1, workspace, &path, expanded, weight);
+}
+
+int AnthillDijkstra::replan(std::vector<int>& path, long long* expanded) {
+    // An existing planner keeps the changes queued for the next compute()
+    if (!dormitory_reachable()) {
+        path.clear();
+        if (expanded) *expanded = 0;
+        return -1;
+    }
+    if (!planner) {
+        planner.emplace(total_rooms, 0, total_rooms - 1);
+        for (int room = 0; room < total_rooms; room++) {
+            planner->set_entry_weight(graph, room, calculate_weight(room, room));
+        }
+    }
+
+    int distance = planner->compute(graph);
+    planner->build_path(graph, path);
+    if (expanded) *expanded = planner->expansions();
+    return distance;
+}
 
-    int start_room = 0;
+int AnthillDijkstra::find_best_path_parallel(std::vector<int>& path, int delta, int threads) {
+    if (!dormitory_reachable()) {
+        path.clear();
+        return -1;
+    }
     int end_room = total_rooms - 1;
+    ShortestPathTree tree = delta_stepping(graph, 0, [this](int from, int to) { return calculate_weight(from, to); },
+                                           delta, threads);
 
-    // Initialize
-    std::vector<int> distances(total_rooms, std::numeric_limits<int>::max());
-    std::vector<int> previous(total_rooms, -1);
-    distances[start_room] = 0;
+    path.clear();
+    if (tree.distance[end_room] == DijkstraWorkspace::UNREACHED) {
+        return -1;
+    }
+    for (int room = end_room; room != -1; room = tree.predecessor[room]) {
+        path.push_back(room);
+    }
+    std::reverse(path.begin(), path.end());
+    return tree.distance[end_room];
+}
 
-    std::priority_queue<Node, std::vector<Node>, std::greater<>> pq;
-    pq.push({start_room, 0, {start_room}});
+int AnthillDijkstra::simulate_dijkstra(long long* expanded) {
+    if (verbose) {
+        out() << "\n" << std::string(60, '=') << "\n";
+        out() << "  🐜 DIJKSTRA ALGORITHM SIMULATION - STARTING" << "\n";
+        out() << "  Rooms: " << total_rooms << " | Ants: " << total_ants << "\n";
+        out() << std::string(60, '=') << "\n\n";
+    }
 
-    std::vector<bool> visited(total_rooms, false);
+    int end_room = total_rooms - 1;
 
-    std::cout << "🔍 Running Dijkstra's algorithm with weighted edges...\n";
-    std::cout << "  Edge weights consider room capacities (lower capacity = higher weight)\n\n";
+    if (verbose) {
+        out() << "🔍 Running Dijkstra's algorithm with weighted edges...\n";
+        out() << "  Edge weights consider room capacities (lower capacity = higher weight)\n\n";
+    }
 
-    // Dijkstra algorithm
-    while (!pq.empty()) {
-        Node current = pq.top();
-        pq.pop();
+    std::vector<int> best_path;
+    int distance = find_best_path(workspace, best_path, expanded);
 
-        if (visited[current.room]) {
-            continue;
+    if (distance < 0) {
+        out() << "❌ No path found from start to dormitory using Dijkstra!\n";
+        return -1;
+    }
+
+    if (verbose) {
+        out() << "🎯 Found shortest weighted path (" << best_path.size() - 1 << " steps, total weight: " 
+              << distance << "):\n  ";
+
+        for (size_t i = 0; i < best_path.size(); ++i) {
+            out() << best_path[i];
+            if (i < best_path.size() - 1) {
+                int weight = calculate_weight(best_path[i], best_path[i + 1]);
+                out() << " →[w=" << weight << "]→ ";
+            }
+        }
+        out() << "\n\n";
+
+        // Path analysis
+        out() << "📊 Path analysis:\n";
+        out() << "  • Total distance (weighted): " << distance << "\n";
+        out() << "  • Number of rooms traversed: " << best_path.size() << "\n";
+        out() << "  • Average weight per edge: " 
+              << std::fixed << std::setprecision(2) 
+              << (double)distance / (best_path.size() - 1) << "\n\n";
+    }
+
+    // Simulate ant movement
+    SimulationStepper simulation({best_path}, room_capacity, total_ants);
+    const std::vector<int>& ants_per_room = simulation.occupancy();
+
+    if (verbose) {
+        out() << std::string(60, '=') << "\n";
+        out() << "  🚀 DIJKSTRA SIMULATION - MOVING ANTS TO DORMITORY" << "\n";
+        out() << "  Using shortest weighted path: ";
+        for (size_t i = 0; i < best_path.size(); ++i) {
+            out() << best_path[i];
+            if (i < best_path.size() - 1) out() << " → ";
         }
+        out() << "\n" << std::string(60, '=') << "\n\n";
+    }
 
-        visited[current.room] = true;
+    if (trace) trace->start_run(room_capacity, total_ants);
 
-        if (current.room == end_room) {
-            // Found path
-            std::cout << "🎯 Found shortest weighted path (" << current.path.size() - 1 << " steps, total weight: " 
-                      << current.distance << "):\n  ";
-            
-            for (size_t i = 0; i < current.path.size(); ++i) {
-                std::cout << current.path[i];
-                if (i < current.path.size() - 1) {
-                    int weight = calculate_weight(current.path[i], current.path[i + 1]);
-                    std::cout << " →[w=" << weight << "]→ ";
+    while (!simulation.done()) {
+        int steps = simulation.steps();
+        if (trace) trace->record(TraceEvent::step(steps));
+        if (verbose) {
+            out() << "\n⏱️  STEP " << steps << "\n";
+            out() << std::string(30, '-') << "\n";
+        }
+
+        // Move ants
+        simulation.advance();
+        for (const AntMove& move : simulation.moves()) {
+            if (trace) trace->record(TraceEvent::move(move.ants, move.from, move.to));
+            if (!verbose) continue;
+            out() << "  🐜 " << move.ants << " ant(s) moved from Room " 
+                << move.from << " to Room " << move.to;
+
+            int weight = calculate_weight(move.from, move.to);
+            if (weight > 1) {
+                out() << " (weight: " << weight << ")";
+            }
+            out() << "\n";
+        }
+
+        // Print status
+        if (verbose) {
+            out() << "\n  ROOM STATUS (" << ants_per_room[end_room] << "/" << total_ants
+                  << " ants in dormitory):\n";
+            for (int i = 0; i < total_rooms; ++i) {
+                std::string room_type = (i == 0) ? "START" : 
+                                       (i == end_room) ? "DORMITORY" : "ROOM";
+                out() << "  • " << room_type << " " << i << ": " 
+                      << ants_per_room[i] << "/" << room_capacity[i] << " ants";
+                if (i == end_room && ants_per_room[i] > 0) {
+                    out() << " 🏠";
                 }
+                out() << "\n";
             }
-            std::cout << "\n\n";
-
-            // Path analysis
-            std::cout << "📊 Path analysis:\n";
-            std::cout << "  • Total distance (weighted): " << current.distance << "\n";
-            std::cout << "  • Number of rooms traversed: " << current.path.size() << "\n";
-            std::cout << "  • Average weight per edge: " 
-                      << std::fixed << std::setprecision(2) 
-                      << (double)current.distance / (current.path.size() - 1) << "\n\n";
-
-            // Simulate ant movement
-            std::vector<int> best_path = current.path;
-            std::vector<int> ants_per_room(total_rooms, 0);
-            ants_per_room[0] = total_ants;
-            int steps = 0;
-
-            std::cout << std::string(60, '=') << "\n";
-            std::cout << "  🚀 DIJKSTRA SIMULATION - MOVING ANTS TO DORMITORY" << "\n";
-            std::cout << "  Using shortest weighted path: ";
-            for (size_t i = 0; i < best_path.size(); ++i) {
-                std::cout << best_path[i];
-                if (i < best_path.size() - 1) std::cout << " → ";
+        }
+
+        if (simulation.stuck()) {
+            if (trace) trace->record(TraceEvent::stuck(steps));
+            out() << "\n⚠️  No movement possible - ants are stuck! Check room capacities.\n";
+            break;
+        }
+
+        // Delay
+        if (verbose) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        }
+    }
+
+    if (verbose) {
+        out() << "\n" << std::string(60, '=') << "\n";
+        out() << "  🎉 DIJKSTRA SIMULATION COMPLETE! 🎉" << "\n";
+        out() << "  All " << total_ants << " ants reached the dormitory" << "\n";
+        out() << "  Total steps: " << simulation.steps() << "\n";
+        out() << "  Dijkstra distance: " << distance << "\n";
+        out() << std::string(60, '=') << "\n\n";
+    }
+    int result = simulation.result();
+    if (trace) trace->record(TraceEvent::finish(result));
+    return result;
+}
+
+std::vector<std::vector<int>> AnthillDijkstra::find_disjoint_paths(int k) {
+    if (!dormitory_reachable()) return {};
+    return find_disjoint_routes(graph, 0, total_rooms - 1, k,
+                                [this](int from, int to) { return calculate_weight(from, to); });
+}
+
+std::vector<int> AnthillDijkstra::split_ants(const std::vector<std::vector<int>>& routes) {
+    // A route of length L whose smallest inner room holds b ants delivers
+    // n ants in about L + ceil(n / b) - 1 steps. Give each ant to the route
+    // that would finish it earliest.
+    std::vector<int> length(routes.size());
+    std::vector<int> bottleneck(routes.size());
+    for (size_t r = 0; r < routes.size(); ++r) {
+        length[r] = static_cast<int>(routes[r].size()) - 1;
+        bottleneck[r] = total_ants;
+        for (size_t i = 1; i + 1 < routes[r].size(); ++i) {
+            bottleneck[r] = std::min(bottleneck[r], room_capacity[routes[r][i]]);
+        }
+        bottleneck[r] = std::max(bottleneck[r], 1);
+    }
+
+    std::vector<int> quota(routes.size(), 0);
+    for (int ant = 0; ant < total_ants; ++ant) {
+        size_t best = 0;
+        int best_finish = std::numeric_limits<int>::max();
+        for (size_t r = 0; r < routes.size(); ++r) {
+            int finish = length[r] + (quota[r] + bottleneck[r]) / bottleneck[r] - 1;
+            if (finish < best_finish) {
+                best_finish = finish;
+                best = r;
             }
-            std::cout << "\n" << std::string(60, '=') << "\n\n";
-
-            while (ants_per_room[end_room] < total_ants) {
-                std::cout << "\n⏱️  STEP " << steps << "\n";
-                std::cout << std::string(30, '-') << "\n";
-                
-                std::vector<int> next_ants = ants_per_room;
-                bool movement_occurred = false;
-
-                // Move ants
-                for (int i = static_cast<int>(best_path.size()) - 2; i >= 0; --i) {
-                    int from = best_path[i];
-                    int to = best_path[i + 1];
-
-                    if (next_ants[from] > 0) {
-                        int capacity_left = room_capacity[to] - next_ants[to];
-                        int can_send = std::min(next_ants[from], capacity_left);
-                        
-                        if (can_send > 0) {
-                            movement_occurred = true;
-                            next_ants[from] -= can_send;
-                            next_ants[to] += can_send;
-                            std::cout << "  🐜 " << can_send << " ant(s) moved from Room " 
-                                    << from << " to Room " << to;
-                            
-                            int weight = calculate_weight(from, to);
-                            if (weight > 1) {
-                                std::cout << " (weight: " << weight << ")";
-                            }
-                            std::cout << "\n";
-                        }
-                    }
-                }
+        }
+        quota[best]++;
+    }
+    return quota;
+}
 
-                ants_per_room = next_ants;
-
-                // Print status
-                std::cout << "\n  ROOM STATUS (" << ants_per_room[end_room] << "/" << total_ants 
-                          << " ants in dormitory):\n";
-                for (int i = 0; i < total_rooms; ++i) {
-                    std::string room_type = (i == 0) ? "START" : 
-                                           (i == end_room) ? "DORMITORY" : "ROOM";
-                    std::cout << "  • " << room_type << " " << i << ": " 
-                              << ants_per_room[i] << "/" << room_capacity[i] << " ants";
-                    if (i == end_room && ants_per_room[i] > 0) {
-                        std::cout << " 🏠";
-                    }
-                    std::cout << "\n";
-                }
+int AnthillDijkstra::simulate_dijkstra_disjoint(int k) {
+    if (verbose) {
+        out() << "\n" << std::string(60, '=') << "\n";
+        out() << "  🐜 DIJKSTRA DISJOINT ROUTES SIMULATION - STARTING" << "\n";
+        out() << "  Rooms: " << total_rooms << " | Ants: " << total_ants << " | Routes: " << k << "\n";
+        out() << std::string(60, '=') << "\n\n";
+    }
 
-                if (!movement_occurred && ants_per_room[end_room] < total_ants) {
-                    std::cout << "\n⚠️  No movement possible - ants are stuck! Check room capacities.\n";
-                    break;
-                }
+    std::vector<std::vector<int>> routes = find_disjoint_paths(k);
+
+    if (routes.empty()) {
+        out() << "❌ No path found from start to dormitory using Dijkstra!\n";
+        return -1;
+    }
+
+    std::vector<int> quota = split_ants(routes);
 
-                steps++;
-                
-                // Delay
-                std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    if (verbose) {
+        out() << "🎯 Found " << routes.size() << " room-disjoint route(s) of minimum total weight:\n";
+        for (size_t r = 0; r < routes.size(); ++r) {
+            int weight = 0;
+            out() << "  🛣️  Route #" << r + 1 << " (" << routes[r].size() - 1 << " steps): ";
+            for (size_t i = 0; i < routes[r].size(); ++i) {
+                out() << routes[r][i];
+                if (i < routes[r].size() - 1) {
+                    weight += calculate_weight(routes[r][i], routes[r][i + 1]);
+                    out() << " → ";
+                }
             }
+            out() << " (weight: " << weight << ", " << quota[r] << " ant(s))\n";
+        }
+    }
+
+    return run_routes(routes, quota);
+}
+
+std::vector<int> AnthillDijkstra::find_widest_path(WidestMethod method) {
+    if (!dormitory_reachable()) return {};
+    return find_widest_route(graph, room_capacity, 0, total_rooms - 1, method);
+}
 
-            std::cout << "\n" << std::string(60, '=') << "\n";
-            std::cout << "  🎉 DIJKSTRA SIMULATION COMPLETE! 🎉" << "\n";
-            std::cout << "  All " << total_ants << " ants reached the dormitory" << "\n";
-            std::cout << "  Total steps: " << steps << "\n";
-            std::cout << "  Dijkstra distance: " << current.distance << "\n";
-            std::cout << std::string(60, '=') << "\n\n";
-
-            return;
-        }
-
-        // Explore neighbors
-        for (int neighbor : graph[current.room]) {
-            if (!visited[neighbor]) {
-                int weight = calculate_weight(current.room, neighbor);
-                int new_distance = current.distance + weight;
-
-                if (new_distance < distances[neighbor]) {
-                    distances[neighbor] = new_distance;
-                    previous[neighbor] = current.room;
-                    
-                    std::vector<int> new_path = current.path;
-                    new_path.push_back(neighbor);
-                    pq.push({neighbor, new_distance, new_path});
+int AnthillDijkstra::simulate_dijkstra_widest(WidestMethod method) {
+    if (verbose) {
+        out() << "\n" << std::string(60, '=') << "\n";
+        out() << "  🐜 DIJKSTRA WIDEST ROUTE SIMULATION - STARTING" << "\n";
+        out() << "  Rooms: " << total_rooms << " | Ants: " << total_ants << "\n";
+        out() << std::string(60, '=') << "\n\n";
+    }
+
+    int bottleneck = 0;
+    std::vector<int> route;
+    if (dormitory_reachable()) {
+        route = find_widest_route(graph, room_capacity, 0, total_rooms - 1, method, &bottleneck);
+    }
+
+    if (route.empty()) {
+        out() << "❌ No path found from start to dormitory using Dijkstra!\n";
+        return -1;
+    }
+
+    if (verbose) {
+        out() << "🎯 Found widest route (" << route.size() - 1 << " steps, "
+              << (method == WidestMethod::UnionFind ? "union-find" : "max-bottleneck Dijkstra") << "): ";
+        for (size_t i = 0; i < route.size(); ++i) {
+            out() << route[i];
+            if (i < route.size() - 1) out() << " → ";
+        }
+        out() << "\n";
+        if (route.size() > 2) {
+            out() << "  • Smallest room on the route holds " << bottleneck << " ant(s)\n";
+        }
+    }
+
+    return run_routes({route}, {total_ants});
+}
+
+SimulationStepper AnthillDijkstra::dijkstra_simulation() {
+    std::vector<int> best_path;
+    if (find_best_path(workspace, best_path) < 0) return SimulationStepper();
+    return SimulationStepper({best_path}, room_capacity, total_ants);
+}
+
+SimulationStepper AnthillDijkstra::disjoint_simulation(int k) {
+    std::vector<std::vector<int>> routes = find_disjoint_paths(k);
+    if (routes.empty()) return SimulationStepper();
+    std::vector<int> quota = split_ants(routes);
+    return SimulationStepper(std::move(routes), room_capacity, total_ants, MoveRule::Flow, std::move(quota));
+}
+
+SimulationStepper AnthillDijkstra::widest_simulation(WidestMethod method) {
+    std::vector<int> route = find_widest_path(method);
+    if (route.empty()) return SimulationStepper();
+    return SimulationStepper({route}, room_capacity, total_ants, MoveRule::Flow, {total_ants});
+}
+
+int AnthillDijkstra::run_routes(const std::vector<std::vector<int>>& routes, std::vector<int> quota) {
+    int end_room = total_rooms - 1;
+
+    // Simulate ant movement, spreading ants over every route
+    SimulationStepper simulation(routes, room_capacity, total_ants, MoveRule::Flow, std::move(quota));
+    const std::vector<int>& ants_per_room = simulation.occupancy();
+
+    if (verbose) {
+        out() << "\n" << std::string(60, '=') << "\n";
+        out() << "  🚀 DIJKSTRA SIMULATION - MOVING ANTS ON " << routes.size() << " ROUTE(S)" << "\n";
+        out() << std::string(60, '=') << "\n\n";
+    }
+
+    if (trace) trace->start_run(room_capacity, total_ants);
+
+    while (!simulation.done()) {
+        int steps = simulation.steps();
+        if (trace) trace->record(TraceEvent::step(steps));
+        if (verbose) {
+            out() << "\n⏱️  STEP " << steps << "\n";
+            out() << std::string(30, '-') << "\n";
+        }
+
+        // Routes only share the start and the dormitory, so each one drains independently
+        simulation.advance();
+        for (const AntMove& move : simulation.moves()) {
+            if (trace) trace->record(TraceEvent::move(move.ants, move.from, move.to));
+            if (!verbose) continue;
+            out() << "  🐜 " << move.ants << " ant(s) moved from Room "
+                  << move.from << " to Room " << move.to << "\n";
+        }
+
+        // Print status
+        if (verbose) {
+            out() << "\n  ROOM STATUS (" << ants_per_room[end_room] << "/" << total_ants
+                  << " ants in dormitory):\n";
+            for (int i = 0; i < total_rooms; ++i) {
+                std::string room_type = (i == 0) ? "START" :
+                                       (i == end_room) ? "DORMITORY" : "ROOM";
+                out() << "  • " << room_type << " " << i << ": "
+                      << ants_per_room[i] << "/" << room_capacity[i] << " ants";
+                if (i == end_room && ants_per_room[i] > 0) {
+                    out() << " 🏠";
                 }
+                out() << "\n";
             }
         }
+
+        if (simulation.stuck()) {
+            if (trace) trace->record(TraceEvent::stuck(steps));
+            out() << "\n⚠️  No movement possible - ants are stuck! Check room capacities.\n";
+            break;
+        }
+
+        // Delay
+        if (verbose) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        }
     }
 
-    std::cout << "❌ No path found from start to dormitory using Dijkstra!\n";
-}
\ No newline at end of file
+    if (verbose) {
+        out() << "\n" << std::string(60, '=') << "\n";
+        out() << "  🎉 DIJKSTRA SIMULATION COMPLETE! 🎉" << "\n";
+        out() << "  All " << total_ants << " ants reached the dormitory" << "\n";
+        out() << "  Total steps: " << simulation.steps() << "\n";
+        out() << std::string(60, '=') << "\n\n";
+    }
+    int result = simulation.result();
+    if (trace) trace->record(TraceEvent::finish(result));
+    return result;
+}
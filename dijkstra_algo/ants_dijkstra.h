@@ -10,32 +10,104 @@
 #include <string>
 #include <thread>
 #include <chrono>
+#include <optional>
+#include "null_stream.h"
+#include "room_connectivity.h"
+#include "search_core.h"
+#include "simulation_stepper.h"
+#include "tunnel_set.h"
+#include "widest_path.h"
+#include "delta_stepping.h"
+#include "incremental_route.h"
+#include "trace_log.h"
 
 class AnthillDijkstra {
-    struct Node {
-        int room;
-        int distance;
-        std::vector<int> path;
-
-        bool operator>(const Node& other) const {
-            return distance > other.distance;
-        }
-    };
-
     int total_rooms;
     int total_ants;
     std::vector<std::vector<int>> graph;
     std::vector<int> room_capacity;
+    TunnelSet tunnels;  // Every tunnel of graph once, for has_tunnel and duplicates
+    RoomConnectivity connected_rooms;
+    bool connectivity_stale = false;  // Set by remove_tunnel, which a union-find cannot undo
+    DijkstraWorkspace workspace;  // Reused by simulate_dijkstra across calls
+    bool verbose = true;
+    TraceLog* trace = nullptr;
+    std::optional<IncrementalRoute> planner;  // Created by the first replan(), then kept in sync
+
+    NullStream quiet;  // Per solver, so quiet runs on several threads share no stream
+
+    // std::cout, or a stream that discards everything when verbose is off
+    std::ostream& out();
+
+    int calculate_weight(int from, int to) const;
 
-    int calculate_weight(int from, int to);
+    // Number of ants to send down each route so that they all finish at about the same time
+    std::vector<int> split_ants(const std::vector<std::vector<int>>& routes);
+
+    // Moves the ants along routes sharing no inner room, at most quota[r] of them
+    // leaving the start by route r. Returns the number of steps, or -1 if stuck.
+    int run_routes(const std::vector<std::vector<int>>& routes, std::vector<int> quota);
 
 public:
     AnthillDijkstra(int total_rooms, int total_ants);
-    void add_tunnels(int a, int b);
+    // Duplicate tunnels and tunnels from a room to itself are refused (false)
+    bool add_tunnels(int a, int b);
+    // Adds a whole edge list, growing the adjacency lists and tunnel set once up front
+    void add_tunnels(const std::vector<std::pair<int, int>>& tunnel_list);
+    // Collapses the a-b tunnel. Returns false if there is none.
+    bool remove_tunnel(int a, int b);
     void set_room_capacity(int room, int capacity);
     bool is_full(int ants, int capacity);
-    bool has_tunnel(int a, int b);
-    void simulate_dijkstra();
+    bool has_tunnel(int a, int b) const;
+
+    // Whether any route joins the start and the dormitory, checked before every
+    // search below. Near O(1) while tunnels are only added; the first call after
+    // remove_tunnel rebuilds the components in O(rooms + tunnels).
+    bool dormitory_reachable();
+
+    // Quiet mode: the simulate_* functions neither print nor pause between steps
+    void set_verbose(bool verbose);
+
+    // Binary trace of every simulation step and move, kept even in quiet mode (null: none)
+    void set_trace(TraceLog* trace);
+
+    // Headless search from room 0 to the dormitory, reusing the buffers in workspace.
+    // Fills path with the best weighted route and returns its distance, or -1 if unreachable;
+    // expanded, if given, receives the number of rooms settled.
+    int find_best_path(DijkstraWorkspace& workspace, std::vector<int>& path, long long* expanded = nullptr);
+
+    // Same distance as find_best_path, but the search is kept between calls and only
+    // the part touched by add_tunnels, remove_tunnel and set_room_capacity since the
+    // previous call is redone. expanded, if given, receives the rooms expanded again.
+    int replan(std::vector<int>& path, long long* expanded = nullptr);
+
+    // Same route and distance as find_best_path, computed by delta-stepping on
+    // `threads` threads with buckets `delta` wide
+    int find_best_path_parallel(std::vector<int>& path, int delta, int threads);
+
+    // Returns the number of steps taken, or -1 on failure. expanded, if given,
+    // receives the number of rooms its find_best_path expanded.
+    int simulate_dijkstra(long long* expanded = nullptr);
+
+    // Up to k routes sharing no room except the start and the dormitory, with minimum
+    // total weight, by increasing weight
+    std::vector<std::vector<int>> find_disjoint_paths(int k);
+
+    // Like simulate_dijkstra, but spreads the ants over up to k disjoint routes
+    int simulate_dijkstra_disjoint(int k);
+
+    // Route whose smallest inner room is as large as possible, then with the fewest
+    // tunnels: the single route with the highest throughput
+    std::vector<int> find_widest_path(WidestMethod method = WidestMethod::Dijkstra);
+
+    // Like simulate_dijkstra, but on the widest route instead of the weighted one
+    int simulate_dijkstra_widest(WidestMethod method = WidestMethod::Dijkstra);
+
+    // The three simulations above as resumable steppers: same routes, same moves,
+    // but the caller pulls each step with advance() and nothing is printed or traced
+    SimulationStepper dijkstra_simulation();
+    SimulationStepper disjoint_simulation(int k);
+    SimulationStepper widest_simulation(WidestMethod method = WidestMethod::Dijkstra);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include "delta_stepping.h"
+#include "search_workspace.h"
+#include "worker_team.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace {
+    // Tunnels as one flat array, weights included
+    struct WeightedGraph {
+        std::vector<int> first;   // Tunnels of room r are [first[r], first[r + 1])
+        std::vector<int> target;
+        std::vector<int> weight;
+    };
+}
+
+ShortestPathTree delta_stepping(const std::vector<std::vector<int>>& graph, int start_room,
+                                const std::function<int(int, int)>& weight, int delta, int threads) {
+    const int UNREACHED = DijkstraWorkspace::UNREACHED;
+    const int rooms = static_cast<int>(graph.size());
+    delta = std::max(1, delta);
+    WorkerTeam team(std::max(1, threads));
+
+    WeightedGraph tunnels;
+    tunnels.first.resize(rooms + 1, 0);
+    for (int room = 0; room < rooms; ++room) {
+        tunnels.first[room + 1] = tunnels.first[room] + static_cast<int>(graph[room].size());
+    }
+    tunnels.target.resize(tunnels.first[rooms]);
+    tunnels.weight.resize(tunnels.first[rooms]);
+    {
+        ChunkCounter chunks(rooms);
+        team.run([&](int) {
+            size_t begin, end;
+            while (chunks.take(begin, end)) {
+                for (size_t room = begin; room < end; ++room) {
+                    int arc = tunnels.first[room];
+                    for (int neighbor : graph[room]) {
+                        tunnels.target[arc] = neighbor;
+                        tunnels.weight[arc] = weight(static_cast<int>(room), neighbor);
+                        ++arc;
+                    }
+                }
+            }
+        });
+    }
+
+    std::unique_ptr<std::atomic<int>[]> distance(new std::atomic<int>[rooms]);
+    for (int room = 0; room < rooms; ++room) distance[room].store(UNREACHED, std::memory_order_relaxed);
+
+    std::vector<std::vector<int>> buckets(1);
+    std::vector<std::vector<std::pair<int, int>>> improved(team.size());  // Per thread: (room, new distance)
+    std::vector<unsigned> frontier_stamp(rooms, 0);
+    std::vector<unsigned> settled_stamp(rooms, 0);
+    unsigned frontier_generation = 0;
+
+    distance[start_room].store(0, std::memory_order_relaxed);
+    buckets[0].push_back(start_room);
+
+    // Relaxes the light or heavy tunnels of every room in `sources`, then files
+    // each room whose distance went down into its bucket
+    auto relax = [&](const std::vector<int>& sources, bool light) {
+        ChunkCounter chunks(sources.size());
+        team.run([&](int thread) {
+            std::vector<std::pair<int, int>>& local = improved[thread];
+            size_t begin, end;
+            while (chunks.take(begin, end)) {
+                for (size_t i = begin; i < end; ++i) {
+                    int room = sources[i];
+                    int room_distance = distance[room].load(std::memory_order_relaxed);
+                    for (int arc = tunnels.first[room]; arc < tunnels.first[room + 1]; ++arc) {
+                        if ((tunnels.weight[arc] <= delta) != light) continue;
+
+                        int neighbor = tunnels.target[arc];
+                        int candidate = room_distance + tunnels.weight[arc];
+                        int current = distance[neighbor].load(std::memory_order_relaxed);
+                        while (candidate < current &&
+                               !distance[neighbor].compare_exchange_weak(current, candidate,
+                                                                         std::memory_order_relaxed)) {
+                        }
+                        if (candidate < current) local.push_back({neighbor, candidate});
+                    }
+                }
+            }
+        });
+
+        for (auto& local : improved) {
+            for (const auto& [room, room_distance] : local) {
+                if (distance[room].load(std::memory_order_relaxed) != room_distance) continue;  // Beaten since
+                size_t bucket = static_cast<size_t>(room_distance / delta);
+                if (bucket >= buckets.size()) buckets.resize(bucket + 1);
+                buckets[bucket].push_back(room);
+            }
+            local.clear();
+        }
+    };
+
+    std::vector<int> frontier;
+    std::vector<int> settled;
+    for (size_t bucket = 0; bucket < buckets.size(); ++bucket) {
+        settled.clear();
+        while (!buckets[bucket].empty()) {
+            // Drop rooms that moved to a lower bucket or are listed twice
+            ++frontier_generation;
+            frontier.clear();
+            for (int room : buckets[bucket]) {
+                bool current = static_cast<size_t>(distance[room].load(std::memory_order_relaxed) / delta) == bucket;
+                if (current && frontier_stamp[room] != frontier_generation) {
+                    frontier_stamp[room] = frontier_generation;
+                    frontier.push_back(room);
+                    if (settled_stamp[room] != bucket + 1) {
+                        settled_stamp[room] = static_cast<unsigned>(bucket + 1);
+                        settled.push_back(room);
+                    }
+                }
+            }
+            buckets[bucket].clear();
+            relax(frontier, true);
+        }
+        relax(settled, false);
+        std::vector<int>().swap(buckets[bucket]);
+    }
+
+    ShortestPathTree tree;
+    tree.distance.resize(rooms);
+    for (int room = 0; room < rooms; ++room) {
+        tree.distance[room] = distance[room].load(std::memory_order_relaxed);
+    }
+
+    // Predecessor: smallest (distance, room) among the tight neighbours, packed in
+    // one 64-bit key so that threads can settle it with an atomic minimum
+    const std::uint64_t NO_KEY = ~std::uint64_t(0);
+    std::unique_ptr<std::atomic<std::uint64_t>[]> best(new std::atomic<std::uint64_t>[rooms]);
+    for (int room = 0; room < rooms; ++room) best[room].store(NO_KEY, std::memory_order_relaxed);
+    {
+        ChunkCounter chunks(rooms);
+        team.run([&](int) {
+            size_t begin, end;
+            while (chunks.take(begin, end)) {
+                for (size_t room = begin; room < end; ++room) {
+                    int room_distance = tree.distance[room];
+                    if (room_distance == UNREACHED) continue;
+                    std::uint64_t key = (static_cast<std::uint64_t>(room_distance) << 32) | room;
+                    for (int arc = tunnels.first[room]; arc < tunnels.first[room + 1]; ++arc) {
+                        int neighbor = tunnels.target[arc];
+                        if (neighbor == start_room ||
+                            tree.distance[neighbor] != room_distance + tunnels.weight[arc]) {
+                            continue;
+                        }
+                        std::uint64_t current = best[neighbor].load(std::memory_order_relaxed);
+                        while (key < current &&
+                               !best[neighbor].compare_exchange_weak(current, key, std::memory_order_relaxed)) {
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    tree.predecessor.resize(rooms);
+    for (int room = 0; room < rooms; ++room) {
+        std::uint64_t key = best[room].load(std::memory_order_relaxed);
+        tree.predecessor[room] = key == NO_KEY ? -1 : static_cast<int>(key & 0xffffffffu);
+    }
+    return tree;
+}
@@ -0,0 +1,30 @@
+#ifndef DELTA_STEPPING_H
+#define DELTA_STEPPING_H
+
+#include <functional>
+#include <vector>
+
+// Distances and predecessors from one start room to every room
+struct ShortestPathTree {
+    std::vector<int> distance;     // DijkstraWorkspace::UNREACHED if unreachable
+    std::vector<int> predecessor;  // -1 for the start room and unreachable rooms
+};
+
+// Single-source shortest paths by delta-stepping (Meyer & Sanders) on `threads` threads.
+//
+// Rooms are kept in buckets of width delta by tentative distance. The lowest
+// non-empty bucket is drained by relaxing the light tunnels (weight <= delta) of
+// all its rooms in parallel, repeatedly, since those can refill the same bucket;
+// the heavy tunnels of every room settled in it are then relaxed once. Distances
+// are lowered with an atomic compare-and-swap, so threads never take a lock while
+// relaxing. A small delta approaches Dijkstra (little wasted work, little
+// parallelism), a large one approaches Bellman-Ford.
+//
+// Weights are read once into a flat adjacency array; weight(from, to) must be
+// positive and safe to call from several threads. The predecessor of a room is the
+// tight neighbour with the smallest (distance, room), which is the one a
+// sequential Dijkstra breaking ties by room id picks, so paths match it exactly.
+ShortestPathTree delta_stepping(const std::vector<std::vector<int>>& graph, int start_room,
+                                const std::function<int(int, int)>& weight, int delta, int threads);
+
+#endif
@@ -0,0 +1,148 @@
+#include "disjoint_routes.h"
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+namespace {
+    struct Arc {
+        int to;
+        int capacity;
+        long long cost;
+        int reverse;  // Index of the paired residual arc in adjacency[to]
+    };
+
+    class FlowNetwork {
+        std::vector<std::vector<Arc>> adjacency;
+
+    public:
+        explicit FlowNetwork(int nodes) : adjacency(nodes) {}
+
+        void add_arc(int from, int to, int capacity, long long cost) {
+            adjacency[from].push_back({to, capacity, cost, static_cast<int>(adjacency[to].size())});
+            adjacency[to].push_back({from, 0, -cost, static_cast<int>(adjacency[from].size()) - 1});
+        }
+
+        const std::vector<Arc>& arcs(int node) const {
+            return adjacency[node];
+        }
+
+        std::vector<Arc>& arcs(int node) {
+            return adjacency[node];
+        }
+
+        // Sends up to `units` units from source to sink, one shortest augmenting path at a time.
+        // Returns the number of units actually sent.
+        int successive_shortest_paths(int source, int sink, int units) {
+            const int nodes = static_cast<int>(adjacency.size());
+            const long long INF = std::numeric_limits<long long>::max() / 4;
+            std::vector<long long> potential(nodes, 0);  // Costs start non-negative
+            std::vector<long long> dist(nodes);
+            std::vector<int> previous_node(nodes);
+            std::vector<int> previous_arc(nodes);
+
+            int sent = 0;
+            while (sent < units) {
+                std::fill(dist.begin(), dist.end(), INF);
+                dist[source] = 0;
+
+                using Entry = std::pair<long long, int>;
+                std::priority_queue<Entry, std::vector<Entry>, std::greater<>> pq;
+                pq.push({0, source});
+
+                while (!pq.empty()) {
+                    auto [d, node] = pq.top();
+                    pq.pop();
+                    if (d > dist[node]) continue;
+
+                    for (size_t i = 0; i < adjacency[node].size(); ++i) {
+                        const Arc& arc = adjacency[node][i];
+                        if (arc.capacity <= 0) continue;
+
+                        long long reduced = arc.cost + potential[node] - potential[arc.to];
+                        if (dist[node] + reduced < dist[arc.to]) {
+                            dist[arc.to] = dist[node] + reduced;
+                            previous_node[arc.to] = node;
+                            previous_arc[arc.to] = static_cast<int>(i);
+                            pq.push({dist[arc.to], arc.to});
+                        }
+                    }
+                }
+
+                if (dist[sink] == INF) break;
+
+                for (int node = 0; node < nodes; ++node) {
+                    if (dist[node] < INF) potential[node] += dist[node];
+                }
+
+                for (int node = sink; node != source; node = previous_node[node]) {
+                    Arc& arc = adjacency[previous_node[node]][previous_arc[node]];
+                    arc.capacity -= 1;
+                    adjacency[node][arc.reverse].capacity += 1;
+                }
+                sent++;
+            }
+            return sent;
+        }
+    };
+}
+
+std::vector<std::vector<int>> find_disjoint_routes(const std::vector<std::vector<int>>& graph,
+                                                   int start_room, int end_room, int k,
+                                                   const std::function<int(int, int)>& weight) {
+    const int rooms = static_cast<int>(graph.size());
+    std::vector<std::vector<int>> routes;
+    if (k <= 0) return routes;
+
+    if (start_room == end_room) {
+        routes.push_back({start_room});
+        return routes;
+    }
+
+    // Node 2r is the entry of room r, 2r + 1 its exit
+    auto entry_node = [](int room) { return 2 * room; };
+    auto exit_node = [](int room) { return 2 * room + 1; };
+
+    FlowNetwork network(2 * rooms);
+    for (int room = 0; room < rooms; ++room) {
+        bool endpoint = room == start_room || room == end_room;
+        network.add_arc(entry_node(room), exit_node(room), endpoint ? k : 1, 0);
+    }
+    for (int room = 0; room < rooms; ++room) {
+        for (int neighbor : graph[room]) {
+            network.add_arc(exit_node(room), entry_node(neighbor), 1, weight(room, neighbor));
+        }
+    }
+
+    int sent = network.successive_shortest_paths(exit_node(start_room), entry_node(end_room), k);
+
+    // Decompose the flow: follow saturated tunnel arcs from the start, consuming them
+    for (int r = 0; r < sent; ++r) {
+        std::vector<int> route = {start_room};
+        int room = start_room;
+        bool complete = true;
+        while (room != end_room && complete) {
+            complete = false;
+            for (Arc& arc : network.arcs(exit_node(room))) {
+                bool tunnel = arc.to % 2 == 0 && arc.cost > 0;
+                if (tunnel && arc.capacity == 0) {
+                    arc.capacity = 1;  // Mark as consumed
+                    room = arc.to / 2;
+                    complete = true;
+                    break;
+                }
+            }
+            if (complete) route.push_back(room);
+        }
+        if (complete) routes.push_back(route);
+    }
+
+    auto route_weight = [&](const std::vector<int>& route) {
+        long long total = 0;
+        for (size_t i = 0; i + 1 < route.size(); ++i) total += weight(route[i], route[i + 1]);
+        return total;
+    };
+    std::stable_sort(routes.begin(), routes.end(), [&](const std::vector<int>& a, const std::vector<int>& b) {
+        return route_weight(a) < route_weight(b);
+    });
+    return routes;
+}
@@ -0,0 +1,21 @@
+#ifndef DISJOINT_ROUTES_H
+#define DISJOINT_ROUTES_H
+
+#include <functional>
+#include <vector>
+
+// Up to k routes from start_room to end_room that share no room other than the
+// two endpoints, with minimum total weight (Suurballe's problem generalised to k).
+//
+// Each room is split into an entry and an exit node joined by a unit-capacity arc,
+// and k units of flow are sent by successive shortest paths; Johnson potentials
+// keep reduced costs non-negative so every augmentation is a plain Dijkstra.
+// The flow is then decomposed into routes, returned by increasing weight.
+// Fewer than k routes are returned if the hill does not have k disjoint ones.
+//
+// weight(from, to) must be positive.
+std::vector<std::vector<int>> find_disjoint_routes(const std::vector<std::vector<int>>& graph,
+                                                   int start_room, int end_room, int k,
+                                                   const std::function<int(int, int)>& weight);
+
+#endif
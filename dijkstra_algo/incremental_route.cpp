@@ -0,0 +1,112 @@
+#include "incremental_route.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace {
+    constexpr int INFINITE = std::numeric_limits<int>::max();
+}
+
+IncrementalRoute::IncrementalRoute(int total_rooms, int start_room, int end_room)
+    : start_room(start_room), end_room(end_room),
+      entry_weight(total_rooms, 1), g(total_rooms, INFINITE), rhs(total_rooms, INFINITE),
+      queued_key(total_rooms, -1) {
+    rhs[start_room] = 0;
+    queued_key[start_room] = 0;
+    queue.push_back({0, start_room});
+}
+
+int IncrementalRoute::key(int room) const {
+    return std::min(g[room], rhs[room]);
+}
+
+void IncrementalRoute::update_room(const std::vector<std::vector<int>>& graph, int room) {
+    if (room != start_room) {
+        int best = INFINITE;
+        for (int neighbor : graph[room]) {
+            if (g[neighbor] != INFINITE) {
+                long long through = static_cast<long long>(g[neighbor]) + entry_weight[room];
+                best = static_cast<int>(std::min<long long>(best, through));
+            }
+        }
+        rhs[room] = best;
+    }
+
+    if (g[room] != rhs[room]) {
+        queued_key[room] = key(room);
+        queue.push_back({queued_key[room], room});
+        std::push_heap(queue.begin(), queue.end(), std::greater<>());
+    } else {
+        queued_key[room] = -1;
+    }
+}
+
+void IncrementalRoute::drop_stale_entries() {
+    while (!queue.empty() && queue.front().key != queued_key[queue.front().room]) {
+        std::pop_heap(queue.begin(), queue.end(), std::greater<>());
+        queue.pop_back();
+    }
+}
+
+void IncrementalRoute::set_entry_weight(const std::vector<std::vector<int>>& graph, int room, int weight) {
+    if (entry_weight[room] == weight) return;
+    entry_weight[room] = weight;
+    update_room(graph, room);
+}
+
+void IncrementalRoute::tunnel_changed(const std::vector<std::vector<int>>& graph, int a, int b) {
+    update_room(graph, a);
+    update_room(graph, b);
+}
+
+int IncrementalRoute::compute(const std::vector<std::vector<int>>& graph) {
+    expanded = 0;
+    while (true) {
+        drop_stale_entries();
+        bool end_consistent = g[end_room] == rhs[end_room];
+        if (queue.empty() || (end_consistent && queue.front().key >= key(end_room))) break;
+
+        int room = queue.front().room;
+        std::pop_heap(queue.begin(), queue.end(), std::greater<>());
+        queue.pop_back();
+        queued_key[room] = -1;
+        expanded++;
+
+        if (g[room] > rhs[room]) {
+            // Overconsistent: the room got closer, settle it and tell its neighbours
+            g[room] = rhs[room];
+        } else {
+            // Underconsistent: the room got further, forget its distance and redo it
+            g[room] = INFINITE;
+            update_room(graph, room);
+        }
+        for (int neighbor : graph[room]) {
+            update_room(graph, neighbor);
+        }
+    }
+    return g[end_room] == INFINITE ? -1 : g[end_room];
+}
+
+void IncrementalRoute::build_path(const std::vector<std::vector<int>>& graph, std::vector<int>& path) const {
+    path.clear();
+    if (g[end_room] == INFINITE) return;
+
+    // Walk back along neighbours that account exactly for each distance
+    path.push_back(end_room);
+    for (int room = end_room; room != start_room;) {
+        int previous = -1;
+        for (int neighbor : graph[room]) {
+            if (g[neighbor] != INFINITE && g[neighbor] + entry_weight[room] == g[room] &&
+                (previous == -1 || neighbor < previous)) {
+                previous = neighbor;
+            }
+        }
+        if (previous == -1 || path.size() > g.size()) {
+            path.clear();  // Only reachable if compute() was not called after a change
+            return;
+        }
+        path.push_back(previous);
+        room = previous;
+    }
+    std::reverse(path.begin(), path.end());
+}
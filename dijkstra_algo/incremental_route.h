@@ -0,0 +1,62 @@
+#ifndef INCREMENTAL_ROUTE_H
+#define INCREMENTAL_ROUTE_H
+
+#include <vector>
+
+// Shortest route from start_room to end_room that is repaired, not recomputed,
+// when the hill changes (Lifelong Planning A*, Koenig & Likhachev).
+//
+// Every room keeps g, its distance as of the last search, and rhs, the best
+// distance its neighbours currently offer. A change only touches the rhs of the
+// rooms at its ends; rooms where g != rhs go back in the queue and are expanded
+// again, and the search stops as soon as the dormitory is consistent and nothing
+// in the queue can improve it. Unaffected parts of the search are left alone.
+//
+// Rooms have no coordinates, so the heuristic is zero: this is the incremental
+// form of Dijkstra. Entering a room costs its entry weight, whatever tunnel is
+// taken. The planner does not own the tunnels: callers pass the current graph to
+// every call and report each change to it.
+class IncrementalRoute {
+public:
+    IncrementalRoute(int total_rooms, int start_room, int end_room);
+
+    // Changes the cost of entering room
+    void set_entry_weight(const std::vector<std::vector<int>>& graph, int room, int weight);
+
+    // To be called after the tunnel a-b was added to or removed from graph
+    void tunnel_changed(const std::vector<std::vector<int>>& graph, int a, int b);
+
+    // Brings the search up to date. Returns the distance to end_room, or -1.
+    int compute(const std::vector<std::vector<int>>& graph);
+
+    // Route found by the last compute(), empty if end_room is unreachable
+    void build_path(const std::vector<std::vector<int>>& graph, std::vector<int>& path) const;
+
+    // Rooms expanded by the last compute()
+    long long expansions() const { return expanded; }
+
+private:
+    struct QueueEntry {
+        int key;
+        int room;
+
+        bool operator>(const QueueEntry& other) const {
+            return key != other.key ? key > other.key : room > other.room;
+        }
+    };
+
+    int start_room;
+    int end_room;
+    std::vector<int> entry_weight;
+    std::vector<int> g;
+    std::vector<int> rhs;
+    std::vector<int> queued_key;     // Key of the room's live queue entry, -1 if not queued
+    std::vector<QueueEntry> queue;   // Min-heap; entries not matching queued_key are stale
+    long long expanded = 0;
+
+    int key(int room) const;
+    void update_room(const std::vector<std::vector<int>>& graph, int room);
+    void drop_stale_entries();
+};
+
+#endif
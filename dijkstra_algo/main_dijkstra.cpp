@@ -1,5 +1,6 @@
 #include <iostream>
 #include "ants_dijkstra.h"
+#include "room_hills.h"
 
 int main() {
     // Anthill 1: Small anthill with 4 rooms and 2 ants
@@ -146,5 +147,56 @@ int main() {
         anthill.simulate_dijkstra();
     }
 
+    // Anthill 7: King hill, four parallel branches used as disjoint routes
+    {
+        std::cout << "\n\n===== ANTHILL 7: KING HILL, DISJOINT ROUTES (23 rooms, 100 ants) =====\n";
+        AnthillDijkstra anthill = room_hills()[6].build<AnthillDijkstra>();
+
+        anthill.simulate_dijkstra_disjoint(4);
+    }
+
+    // Anthill 8: Extra large hill, single route with the largest bottleneck
+    {
+        std::cout << "\n\n===== ANTHILL 8: EXTRA LARGE HILL, WIDEST ROUTE (16 rooms, 50 ants) =====\n";
+        AnthillDijkstra anthill = room_hills()[5].build<AnthillDijkstra>();
+
+        anthill.simulate_dijkstra_widest(WidestMethod::UnionFind);
+    }
+
+    // Anthill 9: Extra large hill, a tunnel of the best route collapses
+    {
+        std::cout << "\n\n===== ANTHILL 9: EXTRA LARGE HILL, COLLAPSING TUNNEL (16 rooms, 50 ants) =====\n";
+        AnthillDijkstra anthill = room_hills()[5].build<AnthillDijkstra>();
+
+        auto print_route = [](const std::vector<int>& route) {
+            for (size_t i = 0; i < route.size(); ++i) {
+                std::cout << (i ? " -> " : "") << route[i];
+            }
+            std::cout << "\n";
+        };
+
+        std::vector<int> route;
+        long long expanded = 0;
+        anthill.replan(route, &expanded);
+        if (route.size() < 2) {
+            std::cout << "No route from the start to the dormitory\n";
+        } else {
+            std::cout << "Best route (" << expanded << " rooms expanded): ";
+            print_route(route);
+
+            std::cout << "Tunnel " << route[route.size() - 2] << " - " << route.back() << " collapses\n";
+            anthill.remove_tunnel(route[route.size() - 2], route.back());
+            anthill.replan(route, &expanded);
+            if (route.empty()) {
+                std::cout << "No route left after the collapse (" << expanded << " rooms expanded again)\n";
+            } else {
+                std::cout << "Repaired route (" << expanded << " rooms expanded again): ";
+                print_route(route);
+            }
+        }
+
+        anthill.simulate_dijkstra();
+    }
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include "widest_path.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <queue>
+
+namespace {
+    const int UNLIMITED = std::numeric_limits<int>::max();
+
+    bool crossable(const std::vector<int>& room_capacity, int room, int start_room, int end_room) {
+        return room == start_room || room == end_room || room_capacity[room] > 0;
+    }
+
+    // Largest bottleneck by a Dijkstra that always expands the widest room first
+    int widest_by_dijkstra(const std::vector<std::vector<int>>& graph, const std::vector<int>& room_capacity,
+                           int start_room, int end_room) {
+        std::vector<int> width(graph.size(), -1);
+        std::vector<char> done(graph.size(), 0);
+        std::priority_queue<std::pair<int, int>> queue;  // (width, room), widest on top
+
+        width[start_room] = UNLIMITED;
+        queue.push({UNLIMITED, start_room});
+
+        while (!queue.empty()) {
+            auto [room_width, room] = queue.top();
+            queue.pop();
+            if (done[room]) continue;
+            done[room] = 1;
+            if (room == end_room) return room_width;
+
+            for (int neighbor : graph[room]) {
+                if (done[neighbor] || !crossable(room_capacity, neighbor, start_room, end_room)) continue;
+                int through = neighbor == end_room ? room_width : std::min(room_width, room_capacity[neighbor]);
+                if (through > width[neighbor]) {
+                    width[neighbor] = through;
+                    queue.push({through, neighbor});
+                }
+            }
+        }
+        return -1;
+    }
+
+    class DisjointSets {
+        std::vector<int> parent;
+        std::vector<int> rank;
+
+    public:
+        explicit DisjointSets(int size) : parent(size), rank(size, 0) {
+            std::iota(parent.begin(), parent.end(), 0);
+        }
+
+        int find(int x) {
+            while (parent[x] != x) {
+                parent[x] = parent[parent[x]];  // Path halving
+                x = parent[x];
+            }
+            return x;
+        }
+
+        void unite(int a, int b) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return;
+            if (rank[a] < rank[b]) std::swap(a, b);
+            parent[b] = a;
+            if (rank[a] == rank[b]) rank[a]++;
+        }
+    };
+
+    // Largest bottleneck by adding rooms from the widest down until start and end connect
+    int widest_by_union_find(const std::vector<std::vector<int>>& graph, const std::vector<int>& room_capacity,
+                             int start_room, int end_room) {
+        const int rooms = static_cast<int>(graph.size());
+        DisjointSets sets(rooms);
+        std::vector<char> added(rooms, 0);
+
+        auto add_room = [&](int room) {
+            added[room] = 1;
+            for (int neighbor : graph[room]) {
+                if (added[neighbor]) sets.unite(room, neighbor);
+            }
+        };
+
+        add_room(start_room);
+        add_room(end_room);
+        if (sets.find(start_room) == sets.find(end_room)) return UNLIMITED;
+
+        std::vector<int> order;
+        for (int room = 0; room < rooms; ++room) {
+            if (room != start_room && room != end_room && room_capacity[room] > 0) order.push_back(room);
+        }
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return room_capacity[a] > room_capacity[b]; });
+
+        for (int room : order) {
+            add_room(room);
+            if (sets.find(start_room) == sets.find(end_room)) return room_capacity[room];
+        }
+        return -1;
+    }
+
+    // Fewest-tunnel route using only rooms of at least min_capacity
+    std::vector<int> shortest_route(const std::vector<std::vector<int>>& graph, const std::vector<int>& room_capacity,
+                                    int start_room, int end_room, int min_capacity) {
+        std::vector<int> previous(graph.size(), -1);
+        std::vector<int> queue = {start_room};
+        previous[start_room] = start_room;
+
+        for (size_t head = 0; head < queue.size() && previous[end_room] < 0; ++head) {
+            int room = queue[head];
+            for (int neighbor : graph[room]) {
+                bool wide_enough = neighbor == end_room || room_capacity[neighbor] >= min_capacity;
+                if (previous[neighbor] < 0 && neighbor != start_room && wide_enough) {
+                    previous[neighbor] = room;
+                    if (neighbor != end_room) queue.push_back(neighbor);
+                }
+            }
+        }
+
+        std::vector<int> route;
+        if (previous[end_room] < 0) return route;
+        for (int room = end_room; room != start_room; room = previous[room]) route.push_back(room);
+        route.push_back(start_room);
+        std::reverse(route.begin(), route.end());
+        return route;
+    }
+}
+
+std::vector<int> find_widest_route(const std::vector<std::vector<int>>& graph,
+                                   const std::vector<int>& room_capacity,
+                                   int start_room, int end_room, WidestMethod method,
+                                   int* bottleneck) {
+    if (start_room == end_room) {
+        if (bottleneck) *bottleneck = UNLIMITED;
+        return {start_room};
+    }
+
+    int widest = method == WidestMethod::UnionFind
+                     ? widest_by_union_find(graph, room_capacity, start_room, end_room)
+                     : widest_by_dijkstra(graph, room_capacity, start_room, end_room);
+    if (bottleneck) *bottleneck = widest;
+    if (widest < 0) return {};
+
+    return shortest_route(graph, room_capacity, start_room, end_room, widest);
+}
@@ -0,0 +1,29 @@
+#ifndef WIDEST_PATH_H
+#define WIDEST_PATH_H
+
+#include <vector>
+
+// How find_widest_route finds the best bottleneck
+enum class WidestMethod {
+    Dijkstra,   // Max-heap on the bottleneck reached so far, O(E log V)
+    UnionFind   // Rooms added by decreasing capacity until start and end meet, O(V log V + E α(V))
+};
+
+// Route from start_room to end_room whose smallest inner room (endpoints excluded)
+// is as large as possible, i.e. the single route with the highest throughput.
+// Among the routes with that bottleneck, one with the fewest tunnels is returned.
+//
+// Maximising the bottleneck then the length is not a single Dijkstra: a wider
+// but longer prefix can lose to a narrower, shorter one once a small room is
+// reached. So the bottleneck is found first, then a BFS restricted to rooms at
+// least that large picks the shortest route. Both methods return the same route.
+//
+// Rooms with no capacity cannot be crossed. Returns an empty route if end_room cannot
+// be reached. bottleneck, if given, receives the smallest inner capacity, or INT_MAX
+// when the route has no inner room.
+std::vector<int> find_widest_route(const std::vector<std::vector<int>>& graph,
+                                   const std::vector<int>& room_capacity,
+                                   int start_room, int end_room, WidestMethod method,
+                                   int* bottleneck = nullptr);
+
+#endif
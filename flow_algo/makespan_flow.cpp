@@ -0,0 +1,255 @@
+#include "makespan_flow.h"
+#include <algorithm>
+
+namespace {
+    // Dinic max flow on a flat arc list (arc i ^ 1 is the residual pair of arc i)
+    class MaxFlow {
+        std::vector<int> first_arc;
+        std::vector<int> next_arc;
+        std::vector<int> head;
+        std::vector<int> capacity;
+        std::vector<int> level;
+        std::vector<int> current_arc;
+        std::vector<int> queue;
+
+        bool build_levels(int source, int sink) {
+            std::fill(level.begin(), level.end(), -1);
+            queue.clear();
+            queue.push_back(source);
+            level[source] = 0;
+            for (size_t i = 0; i < queue.size(); ++i) {
+                int node = queue[i];
+                if (level[sink] >= 0 && level[node] >= level[sink]) break;  // Nothing beyond the sink's layer is used
+                for (int arc = first_arc[node]; arc != -1; arc = next_arc[arc]) {
+                    if (capacity[arc] > 0 && level[head[arc]] < 0) {
+                        level[head[arc]] = level[node] + 1;
+                        queue.push_back(head[arc]);
+                    }
+                }
+            }
+            return level[sink] >= 0;
+        }
+
+        // Iterative augmenting DFS along the level graph
+        int augment(int source, int sink, int limit) {
+            std::vector<int>& path = queue;  // Reused: arcs from source to the current node
+            path.clear();
+            int node = source;
+
+            while (true) {
+                if (node == sink) {
+                    int pushed = limit;
+                    for (int arc : path) pushed = std::min(pushed, capacity[arc]);
+                    for (int arc : path) {
+                        capacity[arc] -= pushed;
+                        capacity[arc ^ 1] += pushed;
+                    }
+                    return pushed;
+                }
+
+                int& arc = current_arc[node];
+                while (arc != -1 && !(capacity[arc] > 0 && level[head[arc]] == level[node] + 1)) {
+                    arc = next_arc[arc];
+                }
+
+                if (arc != -1) {
+                    path.push_back(arc);
+                    node = head[arc];
+                } else {
+                    // Dead end: drop the node from the level graph and back up
+                    level[node] = -1;
+                    if (path.empty()) return 0;
+                    int back = path.back();
+                    path.pop_back();
+                    node = head[back ^ 1];
+                    current_arc[node] = next_arc[current_arc[node]];
+                }
+            }
+        }
+
+    public:
+        int add_node() {
+            first_arc.push_back(-1);
+            return static_cast<int>(first_arc.size()) - 1;
+        }
+
+        void add_arc(int from, int to, int cap) {
+            head.push_back(to);
+            capacity.push_back(cap);
+            next_arc.push_back(first_arc[from]);
+            first_arc[from] = static_cast<int>(head.size()) - 1;
+
+            head.push_back(from);
+            capacity.push_back(0);
+            next_arc.push_back(first_arc[to]);
+            first_arc[to] = static_cast<int>(head.size()) - 1;
+        }
+
+        long long nodes() const { return static_cast<long long>(first_arc.size()); }
+        long long arcs() const { return static_cast<long long>(head.size()) / 2; }
+
+        // Max flow, stopping as soon as `target` units have been pushed
+        int run(int source, int sink, int target) {
+            level.assign(first_arc.size(), -1);
+            int flow = 0;
+            while (flow < target && build_levels(source, sink)) {
+                current_arc = first_arc;
+                int pushed;
+                while (flow < target && (pushed = augment(source, sink, target - flow)) > 0) {
+                    flow += pushed;
+                }
+            }
+            return flow;
+        }
+    };
+
+    std::vector<int> bfs_distances(const std::vector<std::vector<int>>& graph, const std::vector<char>& usable,
+                                   int source) {
+        std::vector<int> dist(graph.size(), -1);
+        std::vector<int> queue = {source};
+        dist[source] = 0;
+        for (size_t i = 0; i < queue.size(); ++i) {
+            int room = queue[i];
+            for (int neighbor : graph[room]) {
+                if (usable[neighbor] && dist[neighbor] < 0) {
+                    dist[neighbor] = dist[room] + 1;
+                    queue.push_back(neighbor);
+                }
+            }
+        }
+        return dist;
+    }
+
+    // Ants per step through the hill in steady state: max flow with each room split
+    // into an arc of its capacity, capped at total_ants
+    int static_throughput(const std::vector<std::vector<int>>& graph, const std::vector<int>& room_capacity,
+                          const std::vector<char>& usable, int start_room, int end_room, int total_ants) {
+        const int rooms = static_cast<int>(graph.size());
+        MaxFlow network;
+        for (int room = 0; room < rooms; ++room) {
+            network.add_node();
+            network.add_node();
+        }
+        auto in_node = [](int room) { return 2 * room; };
+        auto out_node = [](int room) { return 2 * room + 1; };
+
+        for (int room = 0; room < rooms; ++room) {
+            if (!usable[room]) continue;
+            bool endpoint = room == start_room || room == end_room;
+            network.add_arc(in_node(room), out_node(room), endpoint ? total_ants : room_capacity[room]);
+            for (int neighbor : graph[room]) {
+                if (usable[neighbor]) network.add_arc(out_node(room), in_node(neighbor), total_ants);
+            }
+        }
+        return network.run(out_node(start_room), in_node(end_room), total_ants);
+    }
+
+    // True if total_ants ants can reach the dormitory within `horizon` steps
+    bool feasible(const std::vector<std::vector<int>>& graph, const std::vector<int>& room_capacity,
+                  const std::vector<int>& from_start, const std::vector<int>& to_end,
+                  int start_room, int end_room, int total_ants, int horizon, MakespanStats* stats) {
+        const int rooms = static_cast<int>(graph.size());
+        auto active = [&](int room, int t) {
+            return room != end_room && from_start[room] >= 0 && to_end[room] >= 0 &&
+                   from_start[room] <= t && t + to_end[room] <= horizon;
+        };
+
+        MaxFlow network;
+        int source = network.add_node();
+        int sink = network.add_node();
+
+        // in/out node of every active (room, t), layer by layer; -1 when pruned
+        std::vector<int> in_node(rooms), out_node(rooms);
+        std::vector<int> previous_out(rooms, -1);
+
+        for (int t = 0; t <= horizon; ++t) {
+            for (int room = 0; room < rooms; ++room) {
+                in_node[room] = out_node[room] = -1;
+                if (!active(room, t)) continue;
+
+                in_node[room] = network.add_node();
+                out_node[room] = network.add_node();
+                int capacity = room == start_room ? std::max(room_capacity[room], total_ants)
+                                                  : room_capacity[room];
+                network.add_arc(in_node[room], out_node[room], capacity);
+            }
+
+            if (t == 0) {
+                network.add_arc(source, in_node[start_room], total_ants);
+            } else {
+                for (int room = 0; room < rooms; ++room) {
+                    if (previous_out[room] < 0) continue;
+                    if (in_node[room] >= 0) {
+                        network.add_arc(previous_out[room], in_node[room], total_ants);
+                    }
+                    for (int neighbor : graph[room]) {
+                        if (neighbor == end_room) {
+                            network.add_arc(previous_out[room], sink, total_ants);
+                        } else if (in_node[neighbor] >= 0) {
+                            network.add_arc(previous_out[room], in_node[neighbor], total_ants);
+                        }
+                    }
+                }
+            }
+            previous_out = out_node;
+        }
+
+        if (stats) {
+            stats->flow_checks++;
+            stats->largest_nodes = std::max(stats->largest_nodes, network.nodes());
+            stats->largest_arcs = std::max(stats->largest_arcs, network.arcs());
+        }
+        return network.run(source, sink, total_ants) >= total_ants;
+    }
+}
+
+int minimum_makespan(const std::vector<std::vector<int>>& graph, const std::vector<int>& room_capacity,
+                     int start_room, int end_room, int total_ants, MakespanStats* stats) {
+    if (start_room == end_room || total_ants <= 0) return 0;
+
+    // Rooms that can ever hold an ant
+    std::vector<char> usable(graph.size(), 0);
+    for (size_t room = 0; room < graph.size(); ++room) {
+        usable[room] = room_capacity[room] > 0 || static_cast<int>(room) == start_room ||
+                       static_cast<int>(room) == end_room;
+    }
+
+    std::vector<int> from_start = bfs_distances(graph, usable, start_room);
+    std::vector<int> to_end = bfs_distances(graph, usable, end_room);
+    if (from_start[end_room] < 0) return -1;
+
+    // Pipelining the colony down the shortest route always works:
+    // the first ant arrives after `shortest` steps, then one more per step
+    const int shortest = from_start[end_room];
+    const int upper_bound = shortest + total_ants - 1;
+
+    // At most `throughput` ants fit in a minimum room cut at once, every ant spends a
+    // step in it, and the cut can only be occupied during T - shortest + 1 steps
+    const int throughput = static_throughput(graph, room_capacity, usable, start_room, end_room, total_ants);
+    const int lower_bound = std::min(upper_bound, shortest + (total_ants + throughput - 1) / throughput - 1);
+
+    auto check = [&](int horizon) {
+        return feasible(graph, room_capacity, from_start, to_end, start_room, end_room,
+                        total_ants, horizon, stats);
+    };
+
+    // Doubling the distance past the lower bound, then binary search on (low, high]
+    int low = lower_bound - 1;
+    int high = lower_bound;
+    int gap = 1;
+    while (!check(high)) {
+        if (high >= upper_bound) return -1;  // Unreachable in theory, guards against looping
+        low = high;
+        high = std::min(upper_bound, lower_bound + gap);
+        gap *= 2;
+    }
+    while (high - low > 1) {
+        int mid = low + (high - low) / 2;
+        if (check(mid)) {
+            high = mid;
+        } else {
+            low = mid;
+        }
+    }
+    return high;
+}
@@ -0,0 +1,31 @@
+#ifndef MAKESPAN_FLOW_H
+#define MAKESPAN_FLOW_H
+
+#include <vector>
+
+// Work done by minimum_makespan, for reporting
+struct MakespanStats {
+    int flow_checks = 0;          // Max-flow runs (one per horizon tried)
+    long long largest_nodes = 0;  // Nodes in the biggest time-expanded network built
+    long long largest_arcs = 0;
+};
+
+// Exact minimum number of steps to move total_ants ants from start_room to end_room.
+//
+// Model: in one step every ant may take one tunnel or stay put, and after the step
+// no room holds more ants than its capacity. The start room is treated as holding
+// the whole colony and the dormitory as unlimited.
+//
+// For a horizon T the hill is unrolled into T + 1 layers, (room, t) -> (room, t + 1)
+// for waiting and (room, t) -> (neighbor, t + 1) for each tunnel, each room copy
+// being split by an arc of its capacity. T is feasible iff the max flow reaches
+// total_ants. Only copies with dist(start, room) <= t and t + dist(room, end) <= T
+// are built, which keeps the layers sparse. The search starts from a lower bound
+// given by the static max flow through the rooms, doubles its distance to that
+// bound until T is feasible, then binary searches.
+//
+// Returns -1 if the ants cannot reach the dormitory.
+int minimum_makespan(const std::vector<std::vector<int>>& graph, const std::vector<int>& room_capacity,
+                     int start_room, int end_room, int total_ants, MakespanStats* stats = nullptr);
+
+#endif
@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "ants.h"
+#include "ants_astar.h"
+#include "ants_dijkstra.h"
+#include "room_hills.h"
+#include "trace_log.h"
+#include "trace_replay.h"
+
+void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " record FILE [--solver bfs|astar|dijkstra] [--hill ID] [--cave LAYERS WIDTH ANTS]\n"
+              << "       " << program << " info FILE\n"
+              << "       " << program << " show FILE [--run N] [--from STEP] [--to STEP] [--delay MS]\n"
+              << "record runs each hill quietly (all seven by default) and traces it, one run per hill;\n"
+              << "show replays a run without the solvers, --delay 500 at the pace of the verbose simulations.\n";
+}
+
+// Runs the chosen solver on every hill with the trace attached and nothing printed
+int record(const std::string& path, const std::string& solver, const std::vector<RoomHill>& hills) {
+    TraceLog trace(path);
+    if (!trace.is_open()) {
+        std::cerr << "Cannot write " << path << "\n";
+        return 1;
+    }
+
+    for (size_t i = 0; i < hills.size(); i++) {
+        int steps;
+        if (solver == "bfs") {
+            Anthill anthill = hills[i].build<Anthill>();
+            anthill.set_verbose(false);
+            anthill.set_trace(&trace);
+            steps = anthill.simulate_dfs();
+        } else if (solver == "astar") {
+            AnthillAStar anthill = hills[i].build<AnthillAStar>();
+            anthill.set_verbose(false);
+            anthill.set_trace(&trace);
+            steps = anthill.simulate_astar();
+        } else {
+            AnthillDijkstra anthill = hills[i].build<AnthillDijkstra>();
+            anthill.set_verbose(false);
+            anthill.set_trace(&trace);
+            steps = anthill.simulate_dijkstra();
+        }
+        std::cout << "run " << i << ": " << hills[i].name << ", " << steps << " steps\n";
+    }
+
+    trace.close();
+    std::cout << trace.events() << " events in " << trace.bytes_written() << " bytes\n";
+    return 0;
+}
+
+int info(const TraceReplay& replay) {
+    const auto& runs = replay.runs();
+    std::cout << runs.size() << " run(s)\n";
+    for (size_t i = 0; i < runs.size(); i++) {
+        const auto& run = runs[i];
+        std::cout << "run " << i << ": " << run.rooms() << " rooms, " << run.ants << " ants, "
+                  << run.steps() << " recorded steps, ";
+        if (!run.finished) {
+            std::cout << "cut short";
+        } else if (run.result < 0) {
+            std::cout << "failed";
+        } else {
+            std::cout << "finished in " << run.result << " steps";
+        }
+        std::vector<int> end = replay.occupancy(i, run.steps());
+        if (!end.empty()) std::cout << " (" << end.back() << " ants in the dormitory)";
+        std::cout << "\n";
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    std::string command = argv[1];
+    std::string path = argv[2];
+
+    std::string solver = "dijkstra";
+    std::vector<RoomHill> hills;
+    size_t run = 0;
+    int first = 0;
+    int last = INT_MAX;
+    int delay_ms = 0;
+
+    for (int i = 3; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--solver" && has_value) {
+            solver = argv[++i];
+        } else if (arg == "--hill" && has_value) {
+            size_t id = std::strtoul(argv[++i], nullptr, 10);
+            if (id >= room_hills().size()) {
+                std::cerr << "No hill " << argv[i] << "\n";
+                return 1;
+            }
+            hills.push_back(room_hills()[id]);
+        } else if (arg == "--cave" && i + 3 < argc) {
+            int layers = std::max(1, std::atoi(argv[++i]));
+            int width = std::max(1, std::atoi(argv[++i]));
+            int ants = std::max(1, std::atoi(argv[++i]));
+            hills.push_back(make_cave_hill(layers, width, ants, static_cast<unsigned>(hills.size())));
+        } else if (arg == "--run" && has_value) {
+            run = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--from" && has_value) {
+            first = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--to" && has_value) {
+            last = std::atoi(argv[++i]);
+        } else if (arg == "--delay" && has_value) {
+            delay_ms = std::max(0, std::atoi(argv[++i]));
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (command == "record") {
+        if (solver != "bfs" && solver != "astar" && solver != "dijkstra") {
+            print_usage(argv[0]);
+            return 1;
+        }
+        if (hills.empty()) hills = room_hills();
+        return record(path, solver, hills);
+    }
+
+    if (command != "info" && command != "show") {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    TraceReplay replay;
+    std::string error;
+    if (!replay.open(path, error)) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+    if (command == "info") {
+        return info(replay);
+    }
+
+    if (run >= replay.runs().size()) {
+        std::cerr << path << " has " << replay.runs().size() << " run(s)\n";
+        return 1;
+    }
+    replay.render(run, first, last, std::cout, delay_ms);
+    return 0;
+}
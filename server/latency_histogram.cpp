@@ -0,0 +1,68 @@
+#include "latency_histogram.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    int bucket_of(long long nanoseconds) {
+        long long microseconds = nanoseconds / 1000;
+        int bucket = 0;
+        while (microseconds > 0 && bucket + 1 < LatencyHistogram::BUCKETS) {
+            microseconds >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+    double bucket_upper_us(int bucket) {
+        return static_cast<double>(1LL << bucket);
+    }
+}
+
+void LatencyHistogram::record(long long nanoseconds) {
+    nanoseconds = std::max(0LL, nanoseconds);
+    buckets[bucket_of(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    samples.fetch_add(1, std::memory_order_relaxed);
+    total_ns.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+    long long seen = max_ns.load(std::memory_order_relaxed);
+    while (nanoseconds > seen && !max_ns.compare_exchange_weak(seen, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+double LatencyHistogram::mean_us() const {
+    long long n = count();
+    return n == 0 ? 0.0 : total_ns.load(std::memory_order_relaxed) / 1000.0 / n;
+}
+
+double LatencyHistogram::quantile_us(double q) const {
+    long long n = count();
+    if (n == 0) return 0.0;
+
+    long long rank = std::max(1LL, static_cast<long long>(q * n + 0.999999));
+    long long seen = 0;
+    for (int bucket = 0; bucket < BUCKETS; bucket++) {
+        seen += buckets[bucket].load(std::memory_order_relaxed);
+        if (seen >= rank) return bucket_upper_us(bucket);
+    }
+    return bucket_upper_us(BUCKETS - 1);
+}
+
+std::string LatencyHistogram::bucket_lines() const {
+    long long largest = 0;
+    for (const auto& bucket : buckets) largest = std::max(largest, bucket.load(std::memory_order_relaxed));
+
+    std::ostringstream out;
+    for (int bucket = 0; bucket < BUCKETS; bucket++) {
+        long long n = buckets[bucket].load(std::memory_order_relaxed);
+        if (n == 0) continue;
+
+        long long low = bucket == 0 ? 0 : 1LL << (bucket - 1);
+        std::ostringstream range;
+        range << "[" << low << ", " << (1LL << bucket) << ") us";
+        int bar = static_cast<int>((40 * n + largest - 1) / largest);
+        out << "  " << std::left << std::setw(22) << range.str() << std::right << std::setw(10) << n
+            << "  " << std::string(bar, '#') << "\n";
+    }
+    return out.str();
+}
@@ -0,0 +1,34 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <string>
+
+// Request latencies in power-of-two microsecond buckets: bucket 0 holds requests
+// under 1 us, bucket i those in [2^(i-1), 2^i) us. Recording is lock-free, so
+// every worker thread can write into the same histogram.
+class LatencyHistogram {
+public:
+    static constexpr int BUCKETS = 40;
+
+    void record(long long nanoseconds);
+
+    long long count() const { return samples.load(std::memory_order_relaxed); }
+    double mean_us() const;
+    double max_us() const { return max_ns.load(std::memory_order_relaxed) / 1000.0; }
+
+    // Upper bound of the bucket holding the q-th quantile (0 < q <= 1), in microseconds
+    double quantile_us(double q) const;
+
+    // One line per non-empty bucket: "  [lo, hi) us  count  ####"
+    std::string bucket_lines() const;
+
+private:
+    std::array<std::atomic<long long>, BUCKETS> buckets{};
+    std::atomic<long long> samples{0};
+    std::atomic<long long> total_ns{0};
+    std::atomic<long long> max_ns{0};
+};
+
+#endif
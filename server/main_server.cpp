@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include "query_server.h"
+
+void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--socket PATH] [--threads N] [--cave LAYERS WIDTH ANTS]"
+              << " [--cache N] [--cache-dir DIR]\n"
+              << "Without --socket, requests are read from stdin, one per line.\n";
+}
+
+int main(int argc, char** argv) {
+    std::string socket_path;
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<RoomHill> hills = room_hills();
+    int cache_entries = 1024;
+    std::string cache_directory;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--cache" && i + 1 < argc) {
+            cache_entries = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--cache-dir" && i + 1 < argc) {
+            cache_directory = argv[++i];
+        } else if (arg == "--cave" && i + 3 < argc) {
+            int layers = std::max(1, std::atoi(argv[++i]));
+            int width = std::max(1, std::atoi(argv[++i]));
+            int ants = std::max(1, std::atoi(argv[++i]));
+            hills.push_back(make_cave_hill(layers, width, ants, static_cast<unsigned>(hills.size())));
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Results are memoized unless --cache 0; --cache-dir keeps them across runs
+    std::unique_ptr<ResultCache> cache;
+    if (cache_entries > 0 || !cache_directory.empty()) {
+        cache = std::make_unique<ResultCache>(cache_entries, cache_directory);
+    }
+
+    // Every hill and its three solvers are built here, once
+    QueryServer server(hills, cache.get());
+    std::cerr << hills.size() << " hills loaded\n";
+
+    if (socket_path.empty()) {
+        server.serve(std::cin, std::cout);
+    } else {
+        std::cerr << "Listening on " << socket_path << " with " << threads << " worker thread(s)\n";
+        std::string error;
+        if (!server.serve_socket(socket_path, threads, error)) {
+            std::cerr << "Cannot serve on " << socket_path << ": " << error << "\n";
+            return 1;
+        }
+    }
+
+    std::cerr << "\nRequest latencies:\n" << server.latency_report();
+    return 0;
+}
@@ -0,0 +1,444 @@
+#include "query_server.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include "makespan_flow.h"
+#include "search_core.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define QUERY_SERVER_SOCKETS 1
+#endif
+
+namespace {
+    const char* const COMMAND_NAMES[] = {"hills", "route", "makespan", "simulate", "stats", "invalid"};
+
+    std::vector<std::string> split_words(const std::string& line) {
+        std::istringstream in(line);
+        std::vector<std::string> words;
+        std::string word;
+        while (in >> word) words.push_back(word);
+        return words;
+    }
+
+    // Parses a non-negative integer, -1 if the word is not one
+    int parse_count(const std::string& word) {
+        if (word.empty() || word.size() > 9) return -1;
+        for (char c : word) {
+            if (c < '0' || c > '9') return -1;
+        }
+        return std::stoi(word);
+    }
+
+    std::string route_answer(int cost, const std::vector<int>& path) {
+        std::ostringstream out;
+        out << "ok " << (path.empty() ? -1 : cost);
+        for (int room : path) out << " " << room;
+        out << "\n";
+        return out.str();
+    }
+}
+
+QueryServer::HotHill::HotHill(const RoomHill& hill)
+    : description(hill), key(ResultCache::hash_hill(hill)), graph(hill.adjacency()), compact(graph),
+      bfs(hill.build<Anthill>()), astar(hill.build<AnthillAStar>()), dijkstra(hill.build<AnthillDijkstra>()) {
+    bfs.set_verbose(false);
+    astar.set_verbose(false);
+    dijkstra.set_verbose(false);
+}
+
+QueryServer::QueryServer(const std::vector<RoomHill>& hill_list, ResultCache* cache) : cache(cache) {
+    for (const RoomHill& hill : hill_list) {
+        hills.push_back(std::make_unique<HotHill>(hill));
+    }
+}
+
+QueryServer::HotHill* QueryServer::find_hill(const std::string& id) {
+    int index = parse_count(id);
+    return index >= 0 && index < static_cast<int>(hills.size()) ? hills[index].get() : nullptr;
+}
+
+std::string QueryServer::handle(const std::string& line, bool& keep_open) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::string> words = split_words(line);
+    keep_open = true;
+
+    if (words.empty()) return "error empty request\n";
+    if (words[0] == "quit" || words[0] == "shutdown") {
+        if (words[0] == "shutdown") stopping = true;
+        keep_open = false;
+        return "ok bye\n";
+    }
+
+    Command command = INVALID;
+    for (int c = HILLS; c < INVALID; c++) {
+        if (words[0] == COMMAND_NAMES[c]) command = static_cast<Command>(c);
+    }
+
+    std::string response = answer(command, words);
+    auto end = std::chrono::steady_clock::now();
+    latencies[command].record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    return response;
+}
+
+std::string QueryServer::answer(Command command, const std::vector<std::string>& words) {
+    switch (command) {
+        case HILLS: {
+            std::ostringstream out;
+            out << "ok " << hills.size() << "\n";
+            for (size_t id = 0; id < hills.size(); id++) {
+                const RoomHill& hill = hills[id]->description;
+                out << id << " " << hill.rooms() << " " << hill.ants << " " << hill.name << "\n";
+            }
+            return out.str();
+        }
+        case ROUTE: {
+            HotHill* hill = words.size() == 3 ? find_hill(words[1]) : nullptr;
+            if (!hill) return "error usage: route ID bfs|astar|dijkstra|widest\n";
+            return route(*hill, words[2]);
+        }
+        case MAKESPAN: {
+            HotHill* hill = words.size() == 2 ? find_hill(words[1]) : nullptr;
+            if (!hill) return "error usage: makespan ID\n";
+            const RoomHill& description = hill->description;
+            int steps = cached(*hill, "makespan", [&]() {
+                return minimum_makespan(hill->graph, description.capacities, 0, description.rooms() - 1,
+                                        description.ants);
+            });
+            return "ok " + std::to_string(steps) + "\n";
+        }
+        case SIMULATE: {
+            HotHill* hill = words.size() == 3 || words.size() == 4 ? find_hill(words[1]) : nullptr;
+            int k = words.size() == 4 ? parse_count(words[3]) : 0;
+            // top and disjoint need K >= 1: "top 0" is a bad count, not an unknown method
+            bool needs_count = hill && (words[2] == "top" || words[2] == "disjoint");
+            if (!hill || k < 0 || (needs_count && k == 0)) {
+                return "error usage: simulate ID bfs|astar|dijkstra|widest, or simulate ID top|disjoint K\n";
+            }
+            return simulate(*hill, words[2], k);
+        }
+        case STATS: {
+            std::string report = latency_report();
+            long long lines = std::count(report.begin(), report.end(), '\n');
+            return "ok " + std::to_string(lines) + "\n" + report;
+        }
+        default:
+            return "error unknown command '" + words[0] + "'\n";
+    }
+}
+
+std::string QueryServer::route(HotHill& hill, const std::string& method) {
+    std::vector<int> path;
+
+    if (method == "bfs") {
+        // Anthill::find_shortest_path on the hill's CompactGraph, which nothing edits:
+        // no lock, and all the search state is in the workspace
+        static thread_local BfsWorkspace workspace;
+        if (!hill.bfs.dormitory_reachable()) return route_answer(-1, path);
+        int tunnels = hill.compact.visit([&](const auto& graph) {
+            return best_first_search(graph, 0, graph.size() - 1, workspace, &path);
+        });
+        return route_answer(tunnels, path);
+    }
+    if (method == "astar") {
+        static thread_local DijkstraWorkspace workspace;
+        std::lock_guard<std::mutex> lock(hill.astar_lock);
+        int tunnels = hill.astar.find_best_path(workspace, path);
+        return route_answer(tunnels, path);
+    }
+    if (method == "dijkstra") {
+        static thread_local DijkstraWorkspace workspace;
+        std::lock_guard<std::mutex> lock(hill.dijkstra_lock);
+        int distance = hill.dijkstra.find_best_path(workspace, path);
+        return route_answer(distance, path);
+    }
+    if (method == "widest") {
+        std::lock_guard<std::mutex> lock(hill.dijkstra_lock);
+        path = hill.dijkstra.find_widest_path();
+        return route_answer(static_cast<int>(path.size()) - 1, path);
+    }
+    return "error unknown route method '" + method + "'\n";
+}
+
+int QueryServer::cached(HotHill& hill, const std::string& query, const std::function<int()>& compute) {
+    return cache ? cache->get_or_compute(hill.key, query, compute) : compute();
+}
+
+std::string QueryServer::simulate(HotHill& hill, const std::string& method, int k) {
+    bool with_count = method == "top" || method == "disjoint";
+    bool known = method == "bfs" || method == "astar" || method == "dijkstra" || method == "widest";
+    if (!(known || (with_count && k > 0))) {
+        return "error unknown simulation '" + method + "'\n";
+    }
+
+    std::string query = "simulate_" + method + (with_count ? ":" + std::to_string(k) : "");
+    int steps = cached(hill, query, [&]() { return run_simulation(hill, method, k); });
+    return "ok " + std::to_string(steps) + "\n";
+}
+
+int QueryServer::run_simulation(HotHill& hill, const std::string& method, int k) {
+    if (method == "bfs") {
+        // Enumerates every simple path: prefer "top K" on large hills
+        std::lock_guard<std::mutex> lock(hill.bfs_lock);
+        return hill.bfs.simulate_dfs();
+    }
+    if (method == "top") {
+        std::lock_guard<std::mutex> lock(hill.bfs_lock);
+        return hill.bfs.simulate_top_paths(k);
+    }
+    if (method == "astar") {
+        std::lock_guard<std::mutex> lock(hill.astar_lock);
+        return hill.astar.simulate_astar();
+    }
+    if (method == "disjoint") {
+        std::lock_guard<std::mutex> lock(hill.dijkstra_lock);
+        return hill.dijkstra.simulate_dijkstra_disjoint(k);
+    }
+
+    std::lock_guard<std::mutex> lock(hill.dijkstra_lock);
+    return method == "widest" ? hill.dijkstra.simulate_dijkstra_widest() : hill.dijkstra.simulate_dijkstra();
+}
+
+void QueryServer::serve(std::istream& in, std::ostream& out) {
+    std::string line;
+    bool keep_open = true;
+    while (keep_open && std::getline(in, line)) {
+        out << handle(line, keep_open) << std::flush;
+    }
+}
+
+std::string QueryServer::latency_report() const {
+    std::ostringstream out;
+    out << std::left << std::setw(10) << "COMMAND" << std::right
+        << std::setw(10) << "COUNT" << std::setw(12) << "MEAN (us)" << std::setw(12) << "P50 (us)"
+        << std::setw(12) << "P99 (us)" << std::setw(12) << "MAX (us)" << "\n";
+    for (int c = HILLS; c < COMMANDS; c++) {
+        const LatencyHistogram& histogram = latencies[c];
+        if (histogram.count() == 0) continue;
+        out << std::left << std::setw(10) << COMMAND_NAMES[c] << std::right
+            << std::setw(10) << histogram.count() << std::fixed << std::setprecision(1)
+            << std::setw(12) << histogram.mean_us()
+            << std::setw(12) << "<" + std::to_string(static_cast<long long>(histogram.quantile_us(0.5)))
+            << std::setw(12) << "<" + std::to_string(static_cast<long long>(histogram.quantile_us(0.99)))
+            << std::setw(12) << histogram.max_us() << "\n";
+    }
+    for (int c = HILLS; c < COMMANDS; c++) {
+        if (latencies[c].count() == 0) continue;
+        out << COMMAND_NAMES[c] << ":\n" << latencies[c].bucket_lines();
+    }
+    if (cache) {
+        out << "cache: " << cache->summary() << "\n";
+    }
+    return out.str();
+}
+
+#ifdef QUERY_SERVER_SOCKETS
+
+namespace {
+    // Far beyond any valid request. A longer line is answered with an error and
+    // only its first MAX_REQUEST_BYTES + 1 bytes are ever kept.
+    const size_t MAX_REQUEST_BYTES = 1024;
+
+    // One connected client. Its bytes are read by the I/O thread; complete lines
+    // wait in `requests` until a worker answers them, one at a time and in order.
+    struct Session {
+        int fd;
+        std::string buffer;                // Received, not yet a whole line
+        bool skipping = false;             // Dropping the rest of a line already too long
+        std::deque<std::string> requests;
+        bool scheduled = false;            // In the ready queue, or being answered
+        bool finished = false;             // Sent "quit" or "shutdown", or unreachable
+        bool hung_up = false;              // The client closed its end
+
+        explicit Session(int fd) : fd(fd) {}
+    };
+
+    // Moves the complete lines of session.buffer to its requests. A line that
+    // outgrows the limit is queued at once, cut to MAX_REQUEST_BYTES + 1 bytes,
+    // and its remaining bytes are dropped up to the next newline.
+    void split_requests(Session& session) {
+        size_t newline;
+        while ((newline = session.buffer.find('\n')) != std::string::npos) {
+            if (!session.skipping) session.requests.push_back(session.buffer.substr(0, newline));
+            session.skipping = false;
+            session.buffer.erase(0, newline + 1);
+        }
+        if (session.skipping) {
+            session.buffer.clear();
+        } else if (session.buffer.size() > MAX_REQUEST_BYTES) {
+            session.requests.push_back(session.buffer.substr(0, MAX_REQUEST_BYTES + 1));
+            session.buffer.clear();
+            session.skipping = true;
+        }
+    }
+
+    bool send_all(int fd, const std::string& data) {
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) return false;
+            sent += static_cast<size_t>(n);
+        }
+        return true;
+    }
+}
+
+bool QueryServer::serve_socket(const std::string& path, int threads, std::string& error) {
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        error = "socket path too long";
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, path.c_str());
+
+    int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        error = std::strerror(errno);
+        return false;
+    }
+    ::unlink(path.c_str());
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(listener, 64) < 0) {
+        error = std::strerror(errno);
+        ::close(listener);
+        return false;
+    }
+
+    // Sessions with a request to answer wait here for a free worker. A session is
+    // queued at most once, so its requests are answered in order, and goes to the
+    // back after each answer, so a client sending many requests cannot starve others.
+    std::mutex mutex;
+    std::condition_variable work;
+    std::deque<Session*> ready;
+    std::map<int, std::unique_ptr<Session>> sessions;
+    bool running = true;
+
+    auto schedule = [&](Session& session) {
+        if (session.scheduled || session.finished || session.requests.empty()) return;
+        session.scheduled = true;
+        ready.push_back(&session);
+        work.notify_one();
+    };
+
+    auto worker = [&]() {
+        while (true) {
+            Session* session;
+            std::string line;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                work.wait(lock, [&] { return !ready.empty() || !running; });
+                if (!running) return;
+                session = ready.front();
+                ready.pop_front();
+                line = std::move(session->requests.front());
+                session->requests.pop_front();
+            }
+
+            bool keep_open = true;
+            bool sent = send_all(session->fd, line.size() > MAX_REQUEST_BYTES ? "error request too long\n"
+                                                                             : handle(line, keep_open));
+
+            std::lock_guard<std::mutex> lock(mutex);
+            session->scheduled = false;
+            if (!keep_open || !sent) {
+                // The I/O thread sees the hang-up and closes the session
+                session->finished = true;
+                session->requests.clear();
+                ::shutdown(session->fd, SHUT_RDWR);
+            }
+            schedule(*session);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < std::max(1, threads); t++) workers.emplace_back(worker);
+
+    // The I/O thread: accepts clients and reads every connection, so an idle
+    // client costs a pollfd, not a worker
+    std::vector<pollfd> watched;
+    while (!stopping) {
+        watched.assign(1, pollfd{listener, POLLIN, 0});
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto it = sessions.begin(); it != sessions.end();) {
+                Session& session = *it->second;
+                if ((session.finished || session.hung_up) && !session.scheduled) {
+                    ::close(session.fd);
+                    it = sessions.erase(it);
+                    continue;
+                }
+                if (!session.hung_up) watched.push_back(pollfd{session.fd, POLLIN, 0});
+                ++it;
+            }
+        }
+
+        // Wakes up regularly to notice "shutdown" and sessions ended by a worker
+        if (::poll(watched.data(), watched.size(), 100) <= 0) continue;
+
+        if (watched[0].revents & POLLIN) {
+            int client = ::accept(listener, nullptr, nullptr);
+            if (client >= 0) {
+                std::lock_guard<std::mutex> lock(mutex);
+                sessions.emplace(client, std::make_unique<Session>(client));
+            }
+        }
+
+        for (size_t w = 1; w < watched.size(); w++) {
+            if (watched[w].revents == 0) continue;
+            char chunk[4096];
+            ssize_t received = ::read(watched[w].fd, chunk, sizeof(chunk));
+
+            std::lock_guard<std::mutex> lock(mutex);
+            Session& session = *sessions.at(watched[w].fd);
+            if (received <= 0) {
+                // A last request without its newline is still answered
+                if (!session.skipping && !session.buffer.empty()) {
+                    session.requests.push_back(std::move(session.buffer));
+                    session.buffer.clear();
+                    schedule(session);
+                }
+                session.hung_up = true;
+                continue;
+            }
+            session.buffer.append(chunk, static_cast<size_t>(received));
+            split_requests(session);
+            schedule(session);
+        }
+    }
+
+    {
+        // Requests not yet started are dropped; the ones being answered finish first
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+        ready.clear();
+    }
+    work.notify_all();
+    for (std::thread& t : workers) t.join();
+
+    for (const auto& [fd, session] : sessions) ::close(fd);
+    ::close(listener);
+    ::unlink(path.c_str());
+    return true;
+}
+
+#else
+
+bool QueryServer::serve_socket(const std::string&, int, std::string& error) {
+    error = "Unix domain sockets are not available on this platform";
+    return false;
+}
+
+#endif
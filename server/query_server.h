@@ -0,0 +1,97 @@
+#ifndef QUERY_SERVER_H
+#define QUERY_SERVER_H
+
+#include <array>
+#include <atomic>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "ants.h"
+#include "ants_astar.h"
+#include "ants_dijkstra.h"
+#include "compact_graph.h"
+#include "latency_histogram.h"
+#include "result_cache.h"
+#include "room_hills.h"
+
+// Answers route, makespan and simulation queries on hills built once at startup.
+//
+// Protocol: one request per line, one response per request. A response starts
+// with "ok" or "error"; multi-line responses are "ok N" followed by N lines.
+//
+//   hills                             ok N, then "ID ROOMS ANTS NAME" per hill
+//   route ID bfs|astar|dijkstra|widest
+//                                     ok COST ROOM... (COST -1 if unreachable)
+//   makespan ID                       ok STEPS (exact, time-expanded max flow)
+//   simulate ID bfs|astar|dijkstra|widest
+//   simulate ID top|disjoint K        ok STEPS (-1 if the ants get stuck)
+//   stats                             ok N, then the latency report
+//   quit                              closes the session
+//   shutdown                          closes the session and stops serve_socket
+//
+// Requests may come from several sessions at once. Each solver of a hill is
+// guarded by its own mutex, since the solvers keep scratch state between calls;
+// that state, down to the stream a quiet simulation writes to, belongs to one
+// solver, so requests on different solvers share nothing. makespan queries only
+// read the hill and take no lock.
+//
+// With a cache, makespan and simulate answers are memoized by hill content (see
+// ResultCache) and only computed once; stats then also reports hits and misses.
+class QueryServer {
+public:
+    // cache is optional and must outlive the server
+    explicit QueryServer(const std::vector<RoomHill>& hills, ResultCache* cache = nullptr);
+
+    // Answers one request line. Sets keep_open to false on "quit" and "shutdown".
+    std::string handle(const std::string& line, bool& keep_open);
+
+    // Serves one session on a pair of streams until "quit" or end of input
+    void serve(std::istream& in, std::ostream& out);
+
+    // Listens on a Unix domain socket until a client sends "shutdown". One thread
+    // reads every connection; each complete request line goes to one of `threads`
+    // workers, so idle clients hold no worker. A client's requests are answered in
+    // order; a line over 1 KB gets "error request too long", and a last line with
+    // no newline is answered when the client hangs up. Returns false if the socket
+    // cannot be opened (error receives why).
+    bool serve_socket(const std::string& path, int threads, std::string& error);
+
+    // Per-command count, mean, p50, p99 and max latency, then the histograms
+    std::string latency_report() const;
+
+private:
+    enum Command { HILLS, ROUTE, MAKESPAN, SIMULATE, STATS, INVALID, COMMANDS };
+
+    struct HotHill {
+        RoomHill description;
+        CacheKey key;
+        std::vector<std::vector<int>> graph;
+        CompactGraphSnapshot compact;  // graph again, in the form route bfs searches
+        Anthill bfs;
+        AnthillAStar astar;
+        AnthillDijkstra dijkstra;
+        std::mutex bfs_lock;
+        std::mutex astar_lock;
+        std::mutex dijkstra_lock;
+
+        explicit HotHill(const RoomHill& hill);
+    };
+
+    std::vector<std::unique_ptr<HotHill>> hills;
+    std::array<LatencyHistogram, COMMANDS> latencies;
+    std::atomic<bool> stopping{false};
+    ResultCache* cache;
+
+    std::string answer(Command command, const std::vector<std::string>& words);
+    std::string route(HotHill& hill, const std::string& method);
+    std::string simulate(HotHill& hill, const std::string& method, int k);
+    int run_simulation(HotHill& hill, const std::string& method, int k);
+
+    // compute(), or its cached result for this hill and query
+    int cached(HotHill& hill, const std::string& query, const std::function<int()>& compute);
+    HotHill* find_hill(const std::string& id);
+};
+
+#endif